@@ -0,0 +1,68 @@
+#include <string.h>
+
+#include "address_book.h"
+
+static uint8_t book_count(const addressBook_t *book) {
+    // a corrupted count must never send us outside of the entries
+    return book->count > ADDRESS_BOOK_CAPACITY ? ADDRESS_BOOK_CAPACITY : book->count;
+}
+
+// lower_bound returns the index of the first entry whose key is not less
+// than 'key'.
+static uint8_t lower_bound(const addressBook_t *book, const unsigned char *key) {
+    uint8_t lo = 0;
+    uint8_t hi = book_count(book);
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (memcmp(book->entries[mid].key, key, ADDRESS_BOOK_KEY_LEN) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int address_book_find(const addressBook_t *book, const unsigned char *key) {
+    uint8_t i = lower_bound(book, key);
+    if (i < book_count(book) && memcmp(book->entries[i].key, key, ADDRESS_BOOK_KEY_LEN) == 0) {
+        return i;
+    }
+    return -1;
+}
+
+bool address_book_add(addressBook_t *book, const addressBookEntry_t *entry, address_book_write_fn_t *write) {
+    uint8_t count = book_count(book);
+    uint8_t i = lower_bound(book, entry->key);
+
+    if (i < count && memcmp(book->entries[i].key, entry->key, ADDRESS_BOOK_KEY_LEN) == 0) {
+        write(&book->entries[i], entry, sizeof(*entry));
+        return true;
+    }
+    if (count == ADDRESS_BOOK_CAPACITY) {
+        return false;
+    }
+    // shift the tail up one entry at a time so no store overlaps its source
+    for (uint8_t j = count; j > i; j--) {
+        write(&book->entries[j], &book->entries[j - 1], sizeof(addressBookEntry_t));
+    }
+    write(&book->entries[i], entry, sizeof(*entry));
+    count++;
+    write(&book->count, &count, sizeof(count));
+    return true;
+}
+
+bool address_book_remove(addressBook_t *book, const unsigned char *key, address_book_write_fn_t *write) {
+    uint8_t count = book_count(book);
+    int i = address_book_find(book, key);
+
+    if (i < 0) {
+        return false;
+    }
+    for (uint8_t j = i; j + 1 < count; j++) {
+        write(&book->entries[j], &book->entries[j + 1], sizeof(addressBookEntry_t));
+    }
+    count--;
+    write(&book->count, &count, sizeof(count));
+    return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ADDRESS_BOOK_CAPACITY 32
+// keys use the 34-byte layout of sign requests: a 0 byte, then the Helium key
+#define ADDRESS_BOOK_KEY_LEN 34
+// labels are stored NUL-terminated
+#define ADDRESS_BOOK_LABEL_LEN 16
+
+typedef struct {
+    unsigned char key[ADDRESS_BOOK_KEY_LEN];
+    char label[ADDRESS_BOOK_LABEL_LEN];
+} addressBookEntry_t;
+
+// addressBook_t keeps its entries sorted by key, so that a payee can be found
+// with a binary search.
+typedef struct {
+    uint8_t count;
+    addressBookEntry_t entries[ADDRESS_BOOK_CAPACITY];
+} addressBook_t;
+
+// The book lives in NVM on the device, where every store must go through
+// nvm_write. An address_book_write_fn_t performs such a store.
+typedef void address_book_write_fn_t(void *dst, const void *src, size_t len);
+
+// address_book_find returns the index of 'key' in 'book', or -1.
+int address_book_find(const addressBook_t *book, const unsigned char *key);
+
+// address_book_add inserts or relabels 'entry'. It returns false if the book
+// is full.
+bool address_book_add(addressBook_t *book, const addressBookEntry_t *entry, address_book_write_fn_t *write);
+
+// address_book_remove deletes 'key'. It returns false if 'key' is unknown.
+bool address_book_remove(addressBook_t *book, const unsigned char *key, address_book_write_fn_t *write);
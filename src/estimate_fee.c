@@ -0,0 +1,122 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "txns/helium.h"
+#include "ux/helium_ux.h"
+#include "save_context.h"
+#include "fee.h"
+
+static void write_u64_le(uint8_t *dst, uint64_t n) {
+	for (uint8_t i = 0; i < 8; i++) {
+		dst[i] = n >> (8 * i);
+	}
+}
+
+// handle_set_fee_params is the entry point for the setFeeParams command. The
+// payload is the txn_fee_multiplier and the dc_payload_size chain variables,
+// as 4-byte little-endian integers. From then on, sign requests with a fee
+// of 0 get the fee computed on the device.
+void handle_set_fee_params(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags, volatile unsigned int *tx) {
+	UNUSED(p1); UNUSED(p2); UNUSED(flags); UNUSED(tx);
+	if (dataLength != 8) {
+		THROW(SW_INVALID_PARAM);
+	}
+	uint32_t multiplier = dataBuffer[0] | (dataBuffer[1] << 8) | (dataBuffer[2] << 16) | ((uint32_t)dataBuffer[3] << 24);
+	uint32_t payload_size = dataBuffer[4] | (dataBuffer[5] << 8) | (dataBuffer[6] << 16) | ((uint32_t)dataBuffer[7] << 24);
+	if (!fee_set_params(multiplier, payload_size)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	io_exchange_with_code(SW_OK, 0);
+}
+
+// handle_estimate_fee is the entry point for the estimateFee command. P1 is
+// the INS of a sign command, and P2 and the payload are those of the sign
+// request. Nothing is displayed; the reply is the size of the signed
+// transaction as a 4-byte little-endian integer, followed by its fee as an
+// 8-byte one. Any fee in the request is ignored.
+void handle_estimate_fee(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags, volatile unsigned int *tx) {
+	UNUSED(flags); UNUSED(tx);
+	uint64_t *fee;
+	fee_size_fn_t *size;
+	bool saved;
+
+	switch (p1) {
+	case INS_SIGN_PAYMENT_TXN:
+		saved = save_payment_context(0, p2, dataBuffer, dataLength, &global.paymentContext);
+		fee = &global.paymentContext.fee;
+		size = size_helium_pay_txn;
+		break;
+	case INS_SIGN_STAKE_VALIDATOR_TXN:
+		saved = save_stake_validator_context(0, p2, dataBuffer, dataLength, &global.stakeValidatorContext);
+		fee = &global.stakeValidatorContext.fee;
+		size = size_helium_stake_txn;
+		break;
+	case INS_SIGN_TRANSFER_VALIDATOR_TXN:
+		saved = save_transfer_validator_context(0, p2, dataBuffer, dataLength, &global.transferValidatorContext);
+		fee = &global.transferValidatorContext.fee;
+		size = size_helium_transfer_validator_txn;
+		break;
+	case INS_SIGN_UNSTAKE_VALIDATOR_TXN:
+		saved = save_unstake_validator_context(0, p2, dataBuffer, dataLength, &global.unstakeValidatorContext);
+		fee = &global.unstakeValidatorContext.fee;
+		size = size_helium_unstake_txn;
+		break;
+	case INS_SIGN_BURN_TXN:
+		saved = save_burn_context(0, p2, dataBuffer, dataLength, &global.burnContext);
+		fee = &global.burnContext.fee;
+		size = size_helium_burn_txn;
+		break;
+	case INS_SIGN_TRANSFER_SEC_TXN:
+		saved = save_transfer_sec_context(0, p2, dataBuffer, dataLength, &global.transferSecContext);
+		fee = &global.transferSecContext.fee;
+		size = size_helium_transfer_sec;
+		break;
+	case INS_SIGN_STATE_CHANNEL_OPEN_TXN:
+		saved = save_state_channel_open_context(0, p2, dataBuffer, dataLength, &global.stateChannelOpenContext);
+		fee = &global.stateChannelOpenContext.fee;
+		size = size_helium_state_channel_open_txn;
+		break;
+	case INS_SIGN_OUI_TXN:
+		saved = save_oui_context(0, p2, dataBuffer, dataLength, &global.ouiContext);
+		fee = &global.ouiContext.fee;
+		size = size_helium_oui_txn;
+		break;
+	case INS_SIGN_UPDATE_GATEWAY_OUI_TXN:
+		saved = save_update_gateway_oui_context(0, p2, dataBuffer, dataLength, &global.updateGatewayOuiContext);
+		fee = &global.updateGatewayOuiContext.fee;
+		size = size_helium_update_gateway_oui_txn;
+		break;
+	case INS_SIGN_CREATE_HTLC_TXN:
+		saved = save_create_htlc_context(0, p2, dataBuffer, dataLength, &global.createHtlcContext);
+		fee = &global.createHtlcContext.fee;
+		size = size_helium_create_htlc_txn;
+		break;
+	case INS_SIGN_REDEEM_HTLC_TXN:
+		saved = save_redeem_htlc_context(0, p2, dataBuffer, dataLength, &global.redeemHtlcContext);
+		fee = &global.redeemHtlcContext.fee;
+		size = size_helium_redeem_htlc_txn;
+		break;
+	default:
+		THROW(SW_INVALID_PARAM);
+	}
+	if (!saved) {
+		THROW(SW_INVALID_PARAM);
+	}
+	if (!fee_params_set()) {
+		THROW(SW_IMPROPER_INIT);
+	}
+
+	*fee = 0;
+	fee_fill(fee, size);
+	// size() counts a zeroed signature of the signed size, so with the fee
+	// in place it is the size of the signed transaction
+	uint32_t signed_size = size();
+
+	G_io_apdu_buffer[0] = signed_size;
+	G_io_apdu_buffer[1] = signed_size >> 8;
+	G_io_apdu_buffer[2] = signed_size >> 16;
+	G_io_apdu_buffer[3] = signed_size >> 24;
+	write_u64_le(&G_io_apdu_buffer[4], *fee);
+	io_exchange_with_code(SW_OK, 12);
+}
@@ -0,0 +1,28 @@
+#include "fee.h"
+
+static uint32_t fee_multiplier;
+static uint32_t fee_payload_size;
+
+bool fee_set_params(uint32_t txn_fee_multiplier, uint32_t dc_payload_size) {
+	if (dc_payload_size == 0) {
+		return false;
+	}
+	fee_multiplier = txn_fee_multiplier;
+	fee_payload_size = dc_payload_size;
+	return true;
+}
+
+bool fee_params_set(void) {
+	return fee_payload_size != 0;
+}
+
+uint64_t fee_for_size(uint32_t size) {
+	uint64_t blocks = ((uint64_t)size + fee_payload_size - 1) / fee_payload_size;
+	return blocks * fee_multiplier;
+}
+
+void fee_fill(uint64_t *fee, fee_size_fn_t *size) {
+	if (*fee == 0 && fee_params_set()) {
+		*fee = fee_for_size(size());
+	}
+}
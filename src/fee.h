@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Transaction fees are paid in data credits: txn_fee_multiplier for every
+// started dc_payload_size bytes of the transaction, as encoded without its
+// fee and with zeroed signatures. Both are chain variables, which the host
+// sends once per session with INS_SET_FEE_PARAMS.
+
+// fee_set_params stores the fee parameters until the app exits. It returns
+// false, keeping the previous ones, if dc_payload_size is 0.
+bool fee_set_params(uint32_t txn_fee_multiplier, uint32_t dc_payload_size);
+
+// fee_params_set tells whether fee_set_params was called in this session.
+bool fee_params_set(void);
+
+// fee_for_size returns the fee of a transaction of 'size' bytes.
+uint64_t fee_for_size(uint32_t size);
+
+// A fee_size_fn_t returns the size a transaction builder's fee is based on,
+// for the transaction held in the command context, whose fee must be 0.
+typedef uint32_t fee_size_fn_t(void);
+
+// fee_fill computes '*fee' from size() if the request left it at 0 and the
+// fee parameters are known. Otherwise '*fee' is left alone.
+void fee_fill(uint64_t *fee, fee_size_fn_t *size);
@@ -0,0 +1,20 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "txns/helium.h"
+#include "ux/helium_ux.h"
+#include "ux/helium_review.h"
+#include "response.h"
+
+// handle_get_response is the entry point for the getResponse command. It
+// sends the next chunk of a response that did not fit in one APDU, which
+// the previous reply announced with a 0x61xx status word. Nothing is sent
+// while a review waits for the user, whose answer is the next response.
+void handle_get_response(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags, volatile unsigned int *tx) {
+	UNUSED(p1); UNUSED(p2); UNUSED(dataBuffer); UNUSED(dataLength); UNUSED(flags); UNUSED(tx);
+	if (review_active() || response_pending() == 0) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	io_exchange_response();
+}
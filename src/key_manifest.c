@@ -0,0 +1,73 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include <cx.h>
+#include "txns/helium.h"
+#include "ux/helium_ux.h"
+#include "response.h"
+
+// The getKeyManifest command lets a host cache account keys, by having the
+// device vouch for them with its identity key (see helium.h):
+//
+//   P1_MANIFEST_IDENTITY  replies with the 32-byte identity public key,
+//                         which the host pins once.
+//   P1_MANIFEST_KEYS      replies with the manifest of accounts 'first' to
+//                         'first' + 'count' - 1, followed by the 64-byte
+//                         signature of its SHA-256 by the identity key. The
+//                         payload is 'first' (4 bytes, little-endian) and
+//                         'count' (1 byte, at most MANIFEST_MAX_KEYS).
+//
+// The manifest is the 4 bytes "HKM" 0x01, the key type byte of the
+// network, 'first' and 'count' as in the request, and then the 32-byte
+// public key at 44'/904'/account'/0'/0' of each account in turn. The reply
+// takes two APDUs for the larger ranges.
+
+#define MANIFEST_HEADER_LEN 10
+
+void handle_get_key_manifest(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags, volatile unsigned int *tx) {
+	UNUSED(p2); UNUSED(flags); UNUSED(tx);
+
+	if (p1 == P1_MANIFEST_IDENTITY) {
+		get_identity_pubkey_bytes(G_io_apdu_buffer);
+		io_exchange_with_code(SW_OK, SIZE_OF_PUB_KEY_BIN);
+		return;
+	}
+	if (p1 != P1_MANIFEST_KEYS || dataLength != 5) {
+		THROW(SW_INVALID_PARAM);
+	}
+	uint8_t header[MANIFEST_HEADER_LEN] = {'H', 'K', 'M', 0x01};
+	uint32_t first = dataBuffer[0] | (dataBuffer[1] << 8) | (dataBuffer[2] << 16) | ((uint32_t)dataBuffer[3] << 24);
+	uint8_t count = dataBuffer[4];
+	if (count == 0 || count > MANIFEST_MAX_KEYS || first > ACCOUNT_INDEX_MAX - (uint32_t)(count - 1)) {
+		THROW(SW_INVALID_PARAM);
+	}
+#ifdef HELIUM_TESTNET
+	header[4] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+	header[4] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+	memmove(&header[5], dataBuffer, 5);
+
+	// the manifest is hashed as it is queued, so that it never needs to fit
+	// in one buffer
+	cx_sha256_t hash;
+	uint8_t key[SIZE_OF_PUB_KEY_BIN];
+	cx_sha256_init(&hash);
+	cx_hash(&hash.header, 0, header, sizeof(header), NULL, 0);
+	response_append(header, sizeof(header));
+
+	accountPath_t path = {first, 0, 0};
+	for (uint8_t i = 0; i < count; i++, path.account++) {
+		get_pubkey_bytes(&path, key);
+		cx_hash(&hash.header, 0, key, sizeof(key), NULL, 0);
+		response_append(key, sizeof(key));
+	}
+
+	uint8_t digest[32];
+	uint8_t signature[SIZEOF_SIGNATURE];
+	cx_hash(&hash.header, CX_LAST, NULL, 0, digest, sizeof(digest));
+	sign_identity(signature, digest, sizeof(digest));
+	response_append(signature, sizeof(signature));
+	io_exchange_response();
+}
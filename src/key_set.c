@@ -0,0 +1,41 @@
+#include <string.h>
+
+#include "key_set.h"
+
+// first_slot uses the second byte of the key, the first one of the public
+// key, which is as good as random.
+static uint8_t first_slot(const uint8_t *key) {
+    return key[1] % KEY_SET_SLOTS;
+}
+
+void key_set_reset(keySet_t *set) {
+    memset(set, 0, sizeof(*set));
+}
+
+bool key_set_add(keySet_t *set, const uint8_t *key) {
+    if (set->count >= KEY_SET_CAPACITY) {
+        return false;
+    }
+    uint8_t slot = first_slot(key);
+    // there are more slots than candidates, so a free one is always found
+    while (set->slots[slot] != 0) {
+        slot = (slot + 1) % KEY_SET_SLOTS;
+    }
+    memmove(set->keys[set->count], key, KEY_SET_KEY_LEN);
+    set->slots[slot] = ++set->count;
+    return true;
+}
+
+bool key_set_match(keySet_t *set, const uint8_t *key) {
+    bool matched = false;
+    // the same key may have been sent more than once, so walk the whole
+    // probe chain
+    for (uint8_t slot = first_slot(key); set->slots[slot] != 0; slot = (slot + 1) % KEY_SET_SLOTS) {
+        uint8_t i = set->slots[slot] - 1;
+        if (memcmp(set->keys[i], key, KEY_SET_KEY_LEN) == 0) {
+            set->found[i / 8] |= 1 << (i % 8);
+            matched = true;
+        }
+    }
+    return matched;
+}
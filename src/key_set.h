@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define KEY_SET_CAPACITY 32
+// twice the capacity, so that probe chains stay short
+#define KEY_SET_SLOTS 64
+// keys use the 33-byte Helium layout: the key type, then the public key
+#define KEY_SET_KEY_LEN 33
+
+// keySet_t holds the candidate keys of an address verification, in the order
+// they were sent, and which of them were found on the device. The keys are
+// kept whole: a host could grind a key sharing any shorter part with one of
+// the device, and have it reported as found.
+typedef struct {
+    uint8_t count;
+    // slots[i] is 0 when free, or 1 + the index of a candidate
+    uint8_t slots[KEY_SET_SLOTS];
+    uint8_t keys[KEY_SET_CAPACITY][KEY_SET_KEY_LEN];
+    // bit i % 8 of found[i / 8] is set once candidate i was matched
+    uint8_t found[KEY_SET_CAPACITY / 8];
+} keySet_t;
+
+// key_set_reset empties 'set'.
+void key_set_reset(keySet_t *set);
+
+// key_set_add appends 'key' to the candidates. It returns false if 'set' is
+// full.
+bool key_set_add(keySet_t *set, const uint8_t *key);
+
+// key_set_match marks every candidate equal to 'key' as found, and returns
+// whether there was any.
+bool key_set_match(keySet_t *set, const uint8_t *key);
@@ -24,6 +24,8 @@
 #include "glyphs.h"
 #include "txns/helium.h"
 #include "ux/helium_ux.h"
+#include "ux/helium_review.h"
+#include "response.h"
 
 commandContext global;
 
@@ -37,17 +39,22 @@ void io_exchange_with_code(uint16_t code, uint16_t tx) {
 	io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, tx);
 }
 
+// io_exchange_response sends the next chunk of the queued response (see
+// response.h). The chunk ends with 0x61xx while more remain, and with 0x9000
+// once the response is complete.
+void io_exchange_response(void) {
+	uint16_t tx = response_next(G_io_apdu_buffer);
+	uint16_t left = response_pending();
+	if (left == 0) {
+		io_exchange_with_code(SW_OK, tx);
+	} else {
+		io_exchange_with_code(SW_MORE_DATA | (left > 0xFF ? 0 : left), tx);
+	}
+}
+
 // The APDU protocol uses a single-byte instruction code (INS) to specify
-// which command should be executed. We'll use this code to dispatch on a
-// table of function pointers.
-#define INS_GET_VERSION    0x01
-#define INS_GET_PUBLIC_KEY 0x02
-#define INS_SIGN_PAYMENT_TXN   0x08
-#define INS_SIGN_STAKE_VALIDATOR_TXN   0x09
-#define INS_SIGN_TRANSFER_VALIDATOR_TXN   0x0A
-#define INS_SIGN_UNSTAKE_VALIDATOR_TXN   0x0B
-#define INS_SIGN_BURN_TXN   0x0C
-#define INS_SIGN_TRANSFER_SEC_TXN   0x0D
+// which command should be executed; the codes are listed in helium.h. We'll
+// use this code to dispatch on a table of function pointers.
 
 
 // This is the function signature for a command handler. 'flags' and 'tx' are
@@ -64,6 +71,28 @@ handler_fn_t handle_transfer_validator_txn;
 handler_fn_t handle_unstake_validator_txn;
 handler_fn_t handle_burn_txn;
 handler_fn_t handle_sign_transfer_sec_txn;
+handler_fn_t handle_address_book;
+handler_fn_t handle_get_response;
+handler_fn_t handle_set_fee_params;
+handler_fn_t handle_estimate_fee;
+handler_fn_t handle_sign_batch;
+handler_fn_t handle_verify_addresses;
+handler_fn_t handle_get_key_manifest;
+handler_fn_t handle_sign_routing_txn;
+handler_fn_t handle_state_channel_open_txn;
+handler_fn_t handle_oui_txn;
+handler_fn_t handle_oracle_policy;
+handler_fn_t handle_sign_price_oracle_txn;
+handler_fn_t handle_update_gateway_oui_txn;
+handler_fn_t handle_create_htlc_txn;
+handler_fn_t handle_redeem_htlc_txn;
+
+// batch_reset ends the run of signBatch commands, if any.
+void batch_reset(void);
+// routing_reset ends the streaming of a routing filter, if any.
+void routing_reset(void);
+// verify_reset ends the verifyAddresses run, if any.
+void verify_reset(void);
 
 
 static handler_fn_t* lookupHandler(uint8_t ins) {
@@ -76,6 +105,21 @@ static handler_fn_t* lookupHandler(uint8_t ins) {
 	case INS_SIGN_UNSTAKE_VALIDATOR_TXN: return  handle_unstake_validator_txn;
     case INS_SIGN_BURN_TXN: return  handle_burn_txn;
     case INS_SIGN_TRANSFER_SEC_TXN: return  handle_sign_transfer_sec_txn;
+    case INS_ADDRESS_BOOK: return  handle_address_book;
+    case INS_SET_FEE_PARAMS: return  handle_set_fee_params;
+    case INS_ESTIMATE_FEE: return  handle_estimate_fee;
+    case INS_SIGN_BATCH: return  handle_sign_batch;
+    case INS_VERIFY_ADDRESSES: return  handle_verify_addresses;
+    case INS_GET_KEY_MANIFEST: return  handle_get_key_manifest;
+    case INS_SIGN_ROUTING_TXN: return  handle_sign_routing_txn;
+    case INS_SIGN_STATE_CHANNEL_OPEN_TXN: return  handle_state_channel_open_txn;
+    case INS_SIGN_OUI_TXN: return  handle_oui_txn;
+    case INS_ORACLE_POLICY: return  handle_oracle_policy;
+    case INS_SIGN_PRICE_ORACLE_TXN: return  handle_sign_price_oracle_txn;
+    case INS_SIGN_UPDATE_GATEWAY_OUI_TXN: return  handle_update_gateway_oui_txn;
+    case INS_SIGN_CREATE_HTLC_TXN: return  handle_create_htlc_txn;
+    case INS_SIGN_REDEEM_HTLC_TXN: return  handle_redeem_htlc_txn;
+    case INS_GET_RESPONSE: return  handle_get_response;
         default:                 return NULL;
 	}
 }
@@ -137,6 +181,31 @@ static void helium_main(void) {
 				if (!handlerFn) {
 					THROW(0x6D00);
 				}
+				// Any other command than GET_RESPONSE, which is refused
+				// while a review is active, abandons the review: it takes
+				// over the command context the review shows.
+				if (G_io_apdu_buffer[OFFSET_INS] != INS_GET_RESPONSE && review_active()) {
+					ui_idle();
+				}
+				// A queued response can only be fetched right away.
+				if (G_io_apdu_buffer[OFFSET_INS] != INS_GET_RESPONSE) {
+					response_reset();
+				}
+				// Any other command ends a batch run, but the fetching of
+				// its replies.
+				if (G_io_apdu_buffer[OFFSET_INS] != INS_SIGN_BATCH && G_io_apdu_buffer[OFFSET_INS] != INS_GET_RESPONSE) {
+					batch_reset();
+				}
+				// Any other command also ends the streaming of a routing
+				// filter, as it may start a stream of its own.
+				if (G_io_apdu_buffer[OFFSET_INS] != INS_SIGN_ROUTING_TXN) {
+					routing_reset();
+				}
+				// An address verification keeps its keys in the command
+				// context, which any other command takes over.
+				if (G_io_apdu_buffer[OFFSET_INS] != INS_VERIFY_ADDRESSES) {
+					verify_reset();
+				}
 				handlerFn(G_io_apdu_buffer[OFFSET_P1], G_io_apdu_buffer[OFFSET_P2],
 						G_io_apdu_buffer + OFFSET_CDATA, G_io_apdu_buffer[OFFSET_LC], &flags, &tx);
 
@@ -177,13 +246,31 @@ static void helium_main(void) {
 }
 
 
+#ifdef HELIUM_NATIVE
+
+// The native runner (tests/native) has no SE proxy: its io_exchange serves
+// APDUs from a socket, and it enters the dispatch loop from here.
+void helium_native_main(void) {
+	ui_idle();
+	helium_main();
+}
+
+#else
+
 // Everything below this point is Ledger magic. And the magic isn't well-
 // documented, so if you want to understand it, you'll need to read the
 // source, which you can find in the nanos-secure-sdk repo. Fortunately, you
 // don't need to understand any of this in order to write an app.
 
-// override point, but nothing more to do
+// override point; the Nano S scroller cuts its window out of the full string
+// here, everything else is displayed as is
 void io_seproxyhal_display(const bagl_element_t *element) {
+#if defined(TARGET_NANOS) && !defined(HAVE_UX_FLOW)
+	if (element->component.userid == UI_SCROLL_USERID) {
+		ui_scroll_display(element);
+		return;
+	}
+#endif
 	io_seproxyhal_display_default((bagl_element_t *)element);
 }
 
@@ -215,6 +302,8 @@ unsigned char io_event(unsigned char channel) {
 		break;
 
 	case SEPROXYHAL_TAG_TICKER_EVENT:
+		// pre-sign the transaction under review, if any
+		review_ticker();
 		UX_TICKER_EVENT(G_io_seproxyhal_spi_buffer, {});
 		break;
 
@@ -306,3 +395,5 @@ __attribute__((section(".boot"))) int main(void) {
 	app_exit();
 	return 0;
 }
+
+#endif // HELIUM_NATIVE
@@ -0,0 +1,49 @@
+#include <string.h>
+
+#include "oracle_policy.h"
+
+bool oracle_policy_valid(const oraclePolicy_t *policy) {
+    return policy->approved_price > 0 && policy->max_delta_bps <= ORACLE_POLICY_DELTA_BPS_MAX && policy->min_blocks > 0 &&
+           policy->max_blocks >= policy->min_blocks && policy->max_reports > 0;
+}
+
+// max_delta returns max_delta_bps basis points of 'price', rounded down,
+// without overflowing.
+static uint64_t max_delta(const oraclePolicy_t *policy, uint64_t price) {
+    return price / 10000 * policy->max_delta_bps + price % 10000 * policy->max_delta_bps / 10000;
+}
+
+bool oracle_policy_allows(const oraclePolicy_t *policy, uint64_t price, uint64_t height) {
+    if (policy->enabled != 1 || !oracle_policy_valid(policy)) {
+        return false;
+    }
+    if (policy->signed_count >= policy->max_reports) {
+        return false;
+    }
+    if (height <= policy->last_height || height - policy->last_height < policy->min_blocks ||
+        height - policy->last_height > policy->max_blocks) {
+        return false;
+    }
+    uint64_t delta = price > policy->approved_price ? price - policy->approved_price : policy->approved_price - price;
+    return delta <= max_delta(policy, policy->approved_price);
+}
+
+void oracle_policy_record(oraclePolicy_t *policy, uint64_t price, uint64_t height, oracle_policy_write_fn_t *write) {
+    uint32_t count = policy->signed_count + 1;
+    write(&policy->last_height, &height, sizeof(height));
+    write(&policy->last_price, &price, sizeof(price));
+    write(&policy->signed_count, &count, sizeof(count));
+}
+
+void oracle_policy_set(oraclePolicy_t *stored, const oraclePolicy_t *policy, oracle_policy_write_fn_t *write) {
+    oraclePolicy_t enabled;
+    memmove(&enabled, policy, sizeof(enabled));
+    enabled.enabled = 1;
+    enabled.signed_count = 0;
+    write(stored, &enabled, sizeof(enabled));
+}
+
+void oracle_policy_disable(oraclePolicy_t *stored, oracle_policy_write_fn_t *write) {
+    uint8_t disabled = 0;
+    write(&stored->enabled, &disabled, sizeof(disabled));
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "save_context.h"
+
+// An oracle policy lets price_oracle_v1 reports be signed without a review.
+// The user approves it on the device; from then on a report is signed only
+// if it is for a block at least 'min_blocks' and at most 'max_blocks' after
+// the last one signed (so heights only increase, reports are at most that
+// frequent, and a host cannot skip far ahead), and if its price is within
+// 'max_delta_bps' basis points of the price the user approved, so that the
+// price cannot walk away from it one report at a time. The first report is
+// compared with the reference height the policy was approved with. After
+// 'max_reports' reports, the policy must be approved again.
+#define ORACLE_POLICY_DELTA_BPS_MAX 10000
+
+typedef struct {
+    uint8_t enabled;
+    accountPath_t path;
+    // the Ed25519 key of 'path', derived when the policy is approved
+    unsigned char public_key[32];
+    uint32_t max_delta_bps;
+    uint32_t min_blocks;
+    uint32_t max_blocks;
+    uint32_t max_reports;
+    uint64_t approved_price;
+    uint64_t last_height;
+    uint64_t last_price;
+    uint32_t signed_count;
+} oraclePolicy_t;
+
+// The policy lives in NVM on the device, where every store must go through
+// nvm_write. An oracle_policy_write_fn_t performs such a store.
+typedef void oracle_policy_write_fn_t(void *dst, const void *src, size_t len);
+
+// oracle_policy_valid returns whether 'policy' may be approved: a reference
+// price, a price change of at most 100%, at least one block between reports
+// and no fewer than 'min_blocks' allowed, and at least one report.
+bool oracle_policy_valid(const oraclePolicy_t *policy);
+
+// oracle_policy_allows returns whether a report of 'price' at 'height' may
+// be signed under 'policy'.
+bool oracle_policy_allows(const oraclePolicy_t *policy, uint64_t price, uint64_t height);
+
+// oracle_policy_record makes the report of 'price' at 'height' the last one
+// signed. It is stored before the signature is sent, so that a power loss
+// can never let the same height be signed twice.
+void oracle_policy_record(oraclePolicy_t *policy, uint64_t price, uint64_t height, oracle_policy_write_fn_t *write);
+
+// oracle_policy_set replaces the stored policy with 'policy', enabled.
+void oracle_policy_set(oraclePolicy_t *stored, const oraclePolicy_t *policy, oracle_policy_write_fn_t *write);
+
+// oracle_policy_disable turns the stored policy off.
+void oracle_policy_disable(oraclePolicy_t *stored, oracle_policy_write_fn_t *write);
@@ -21,6 +21,7 @@ typedef struct _helium_blockchain_txn_payment_v2 {
 typedef struct _helium_payment { 
     pb_callback_t payee; 
     uint64_t amount; 
+    uint64_t memo; 
 } helium_payment;
 
 
@@ -30,9 +31,9 @@ extern "C" {
 
 /* Initializer values for message structs */
 #define helium_blockchain_txn_payment_v2_init_default {{{NULL}, NULL}, {{NULL}, NULL}, 0, 0, {{NULL}, NULL}}
-#define helium_payment_init_default              {{{NULL}, NULL}, 0}
+#define helium_payment_init_default              {{{NULL}, NULL}, 0, 0}
 #define helium_blockchain_txn_payment_v2_init_zero {{{NULL}, NULL}, {{NULL}, NULL}, 0, 0, {{NULL}, NULL}}
-#define helium_payment_init_zero                 {{{NULL}, NULL}, 0}
+#define helium_payment_init_zero                 {{{NULL}, NULL}, 0, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define helium_blockchain_txn_payment_v2_payer_tag 1
@@ -57,7 +58,8 @@ X(a, CALLBACK, SINGULAR, BYTES,    signature,         5)
 
 #define helium_payment_FIELDLIST(X, a) \
 X(a, CALLBACK, SINGULAR, BYTES,    payee,             1) \
-X(a, STATIC,   SINGULAR, UINT64,   amount,            2)
+X(a, STATIC,   SINGULAR, UINT64,   amount,            2) \
+X(a, STATIC,   SINGULAR, UINT64,   memo,              3)
 #define helium_payment_CALLBACK pb_default_field_callback
 #define helium_payment_DEFAULT NULL
 
@@ -0,0 +1,38 @@
+#include <string.h>
+#include "response.h"
+
+static uint8_t response[RESPONSE_CAPACITY];
+static uint16_t response_len;
+static uint16_t response_sent;
+
+void response_reset(void) {
+	memset(response, 0, response_len);
+	response_len = 0;
+	response_sent = 0;
+}
+
+bool response_append(const uint8_t *data, uint16_t len) {
+	if (len > RESPONSE_CAPACITY - response_len) {
+		return false;
+	}
+	memmove(&response[response_len], data, len);
+	response_len += len;
+	return true;
+}
+
+uint16_t response_pending(void) {
+	return response_len - response_sent;
+}
+
+uint16_t response_next(uint8_t *dst) {
+	uint16_t len = response_pending();
+	if (len > RESPONSE_CHUNK_SIZE) {
+		len = RESPONSE_CHUNK_SIZE;
+	}
+	memmove(dst, &response[response_sent], len);
+	response_sent += len;
+	if (response_pending() == 0) {
+		response_reset();
+	}
+	return len;
+}
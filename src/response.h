@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Responses that do not fit in one APDU are queued in a bounded outbound
+// buffer and sent in chunks. Every chunk but the last ends with 0x61xx, xx
+// being the number of bytes still queued (00 for 256 or more), and the host
+// fetches the next chunk with INS_GET_RESPONSE. Any other command drops
+// whatever is left.
+#define RESPONSE_CAPACITY 512
+#define RESPONSE_CHUNK_SIZE 255
+
+// response_reset drops the queued response.
+void response_reset(void);
+
+// response_append queues 'len' bytes after the ones already queued. It
+// returns false, queuing nothing, if they do not fit.
+bool response_append(const uint8_t *data, uint16_t len);
+
+// response_pending returns the number of queued bytes not sent yet.
+uint16_t response_pending(void);
+
+// response_next moves the next chunk of at most RESPONSE_CHUNK_SIZE bytes
+// to 'dst' and returns its length.
+uint16_t response_next(uint8_t *dst);
@@ -0,0 +1,42 @@
+#include <string.h>
+
+#include "review_summary.h"
+
+// append copies 'len' bytes of 'src', if they fit with the NUL, and keeps
+// the summary terminated.
+static void append(reviewSummary_t *summary, const char *src, size_t len) {
+    if (summary->overflow || summary->len + len >= summary->size) {
+        summary->overflow = true;
+        return;
+    }
+    memmove(&summary->dst[summary->len], src, len);
+    summary->len += len;
+    summary->dst[summary->len] = '\0';
+}
+
+void review_summary_init(reviewSummary_t *summary, uint8_t *dst, uint16_t size) {
+    summary->dst = dst;
+    summary->size = size;
+    summary->len = 0;
+    summary->overflow = size == 0;
+    if (size > 0) {
+        dst[0] = '\0';
+    }
+}
+
+void review_summary_add(reviewSummary_t *summary, const char *label, const char *value) {
+    size_t len = strlen(value);
+
+    if (summary->len > 0) {
+        append(summary, ", ", 2);
+    }
+    if (label[0] != '\0') {
+        append(summary, label, strlen(label));
+        append(summary, " ", 1);
+    }
+    append(summary, value, len);
+}
+
+bool review_summary_fits(const reviewSummary_t *summary) {
+    return !summary->overflow;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// In expert review mode, a transaction review opens on a single summary line
+// made of the short label and value of a few of its fields, such as
+// "Pay HNT 1.5, To Cold (trusted), Fee 35000"; the full fields stay one step
+// away. Values are never shortened: the ends of an address can be ground to
+// match another one, so an address the user does not trust is shown whole,
+// and a summary it does not fit in is not shown at all.
+
+typedef struct {
+    uint8_t *dst;
+    uint16_t size;
+    uint16_t len;
+    bool overflow;
+} reviewSummary_t;
+
+// review_summary_init starts an empty summary in 'dst', a buffer of 'size'
+// bytes.
+void review_summary_init(reviewSummary_t *summary, uint8_t *dst, uint16_t size);
+
+// review_summary_add appends "label value", after a comma unless it is the
+// first part.
+void review_summary_add(reviewSummary_t *summary, const char *label, const char *value);
+
+// review_summary_fits returns whether every part fit in the buffer, with the
+// terminating NUL. A summary that does not fit must not be shown, as it would
+// hide part of the transaction.
+bool review_summary_fits(const reviewSummary_t *summary);
@@ -9,57 +9,522 @@ static inline uint32_t U4LE(const uint8_t *buf, size_t off) {
 // macros for converting raw bytes to uint64_t
 #define U8LE(buf, off) (((uint64_t)(U4LE(buf, off + 4)) << 32) | ((uint64_t)(U4LE(buf, off))     & 0xFFFFFFFF))
 
-void save_payment_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, __attribute__((unused)) uint16_t dataLength, paymentContext_t *ctx) {
+// compactReader_t decodes the compact requests described in save_context.h.
+// Every read is checked against the length of the request; the first one
+// that fails clears 'ok', and the ones after it read nothing.
+typedef struct {
+    const uint8_t *buf;
+    uint16_t len;
+    uint16_t pos;
+    bool ok;
+    uint8_t present;
+} compactReader_t;
+
+// compact_begin reads the header of a request, which may hold no other
+// REQUEST_HAS_* bits than 'allowed'.
+static void compact_begin(compactReader_t *r, const uint8_t *dataBuffer, uint16_t dataLength, uint8_t allowed) {
+    r->buf = dataBuffer;
+    r->len = dataLength;
+    r->pos = 2;
+    r->present = dataLength >= 2 ? dataBuffer[1] : 0;
+    r->ok = dataLength >= 2 && dataBuffer[0] == REQUEST_COMPACT_VERSION && (r->present & ~allowed) == 0;
+}
+
+// compact_end returns whether the whole request was read, and nothing more.
+static bool compact_end(const compactReader_t *r) {
+    return r->ok && r->pos == r->len;
+}
+
+static uint64_t compact_varint(compactReader_t *r) {
+    uint64_t value = 0;
+    for (uint8_t shift = 0; r->ok; shift += 7) {
+        if (r->pos >= r->len) {
+            break;
+        }
+        uint8_t b = r->buf[r->pos++];
+        // the tenth byte only has room for the top bit
+        if (shift == 63 && b > 1) {
+            break;
+        }
+        value |= (uint64_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            return value;
+        }
+    }
+    r->ok = false;
+    return 0;
+}
+
+// compact_optional reads a varint if 'bit' is present, and returns 0
+// otherwise.
+static uint64_t compact_optional(compactReader_t *r, uint8_t bit) {
+    return (r->present & bit) ? compact_varint(r) : 0;
+}
+
+// compact_key reads a 33-byte key into the 34-byte layout of the contexts.
+static void compact_key(compactReader_t *r, unsigned char *key) {
+    memset(key, 0, SIZEOF_B58_KEY);
+    if (!r->ok || r->len - r->pos < SIZEOF_B58_KEY - 1) {
+        r->ok = false;
+        return;
+    }
+    memmove(&key[1], &r->buf[r->pos], SIZEOF_B58_KEY - 1);
+    r->pos += SIZEOF_B58_KEY - 1;
+}
+
+static void compact_path(compactReader_t *r, uint8_t bit, uint8_t account, accountPath_t *path) {
+    path->account = account;
+    path->change = 0;
+    path->address = 0;
+    if ((r->present & bit) == 0) {
+        return;
+    }
+    uint64_t account_index = compact_varint(r);
+    uint64_t change = compact_varint(r);
+    uint64_t address = compact_varint(r);
+    if (account_index > ACCOUNT_INDEX_MAX || change > ACCOUNT_INDEX_MAX || address > ACCOUNT_INDEX_MAX) {
+        r->ok = false;
+        return;
+    }
+    path->account = account_index;
+    path->change = change;
+    path->address = address;
+}
+
+static bool save_payment_compact(uint8_t p1, uint8_t *dataBuffer, uint16_t dataLength, paymentContext_t *ctx) {
+    compactReader_t r;
+    compact_begin(&r, dataBuffer, dataLength, REQUEST_HAS_FEE | REQUEST_HAS_MEMO | REQUEST_HAS_PATH);
+    ctx->amount = compact_varint(&r);
+    ctx->nonce = compact_varint(&r);
+    compact_key(&r, ctx->payee);
+    ctx->fee = compact_optional(&r, REQUEST_HAS_FEE);
+    ctx->memo = compact_optional(&r, REQUEST_HAS_MEMO);
+    compact_path(&r, REQUEST_HAS_PATH, p1, &ctx->path);
+    return compact_end(&r);
+}
+
+static bool save_stake_validator_compact(uint8_t p1, uint8_t *dataBuffer, uint16_t dataLength, stakeValidatorContext_t *ctx) {
+    compactReader_t r;
+    compact_begin(&r, dataBuffer, dataLength, REQUEST_HAS_FEE | REQUEST_HAS_PATH);
+    ctx->stake = compact_varint(&r);
+    compact_key(&r, ctx->address);
+    ctx->fee = compact_optional(&r, REQUEST_HAS_FEE);
+    compact_path(&r, REQUEST_HAS_PATH, p1, &ctx->path);
+    return compact_end(&r);
+}
+
+static bool save_transfer_validator_compact(uint8_t p1, uint8_t *dataBuffer, uint16_t dataLength, transferValidatorContext_t *ctx) {
+    compactReader_t r;
+    compact_begin(&r, dataBuffer, dataLength, REQUEST_HAS_FEE | REQUEST_HAS_PATH | REQUEST_HAS_NEW_OWNER_PATH);
+    ctx->stake_amount = compact_varint(&r);
+    ctx->payment_amount = compact_varint(&r);
+    compact_key(&r, ctx->new_owner);
+    compact_key(&r, ctx->old_owner);
+    compact_key(&r, ctx->new_address);
+    compact_key(&r, ctx->old_address);
+    ctx->fee = compact_optional(&r, REQUEST_HAS_FEE);
+    compact_path(&r, REQUEST_HAS_PATH, p1, &ctx->path);
+    compact_path(&r, REQUEST_HAS_NEW_OWNER_PATH, 0, &ctx->new_owner_path);
+    ctx->both_owners = (r.present & REQUEST_HAS_NEW_OWNER_PATH) != 0;
+    if (ctx->both_owners && (r.present & REQUEST_HAS_PATH) == 0) {
+        return false;
+    }
+    return compact_end(&r);
+}
+
+static bool save_unstake_validator_compact(uint8_t p1, uint8_t *dataBuffer, uint16_t dataLength, unstakeValidatorContext_t *ctx) {
+    compactReader_t r;
+    compact_begin(&r, dataBuffer, dataLength, REQUEST_HAS_FEE | REQUEST_HAS_PATH);
+    ctx->stake_amount = compact_varint(&r);
+    ctx->stake_release_height = compact_varint(&r);
+    compact_key(&r, ctx->address);
+    ctx->fee = compact_optional(&r, REQUEST_HAS_FEE);
+    compact_path(&r, REQUEST_HAS_PATH, p1, &ctx->path);
+    return compact_end(&r);
+}
+
+static bool save_burn_compact(uint8_t p1, uint8_t *dataBuffer, uint16_t dataLength, burnContext_t *ctx) {
+    compactReader_t r;
+    compact_begin(&r, dataBuffer, dataLength, REQUEST_HAS_FEE | REQUEST_HAS_MEMO | REQUEST_HAS_PATH);
+    ctx->amount = compact_varint(&r);
+    ctx->nonce = compact_varint(&r);
+    compact_key(&r, ctx->payee);
+    ctx->fee = compact_optional(&r, REQUEST_HAS_FEE);
+    ctx->memo = compact_optional(&r, REQUEST_HAS_MEMO);
+    compact_path(&r, REQUEST_HAS_PATH, p1, &ctx->path);
+    return compact_end(&r);
+}
+
+static bool save_transfer_sec_compact(uint8_t p1, uint8_t *dataBuffer, uint16_t dataLength, transferSecContext_t *ctx) {
+    compactReader_t r;
+    compact_begin(&r, dataBuffer, dataLength, REQUEST_HAS_FEE | REQUEST_HAS_PATH);
+    ctx->amount = compact_varint(&r);
+    ctx->nonce = compact_varint(&r);
+    compact_key(&r, ctx->payee);
+    ctx->fee = compact_optional(&r, REQUEST_HAS_FEE);
+    compact_path(&r, REQUEST_HAS_PATH, p1, &ctx->path);
+    return compact_end(&r);
+}
+
+bool save_payment_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, paymentContext_t *ctx) {
+    if (p2 & P2_REQUEST_COMPACT) {
+        return save_payment_compact(p1, dataBuffer, dataLength, ctx);
+    }
     ctx->amount = U8LE(dataBuffer, 0);
     ctx->fee = U8LE(dataBuffer, 8);
     ctx->nonce = U8LE(dataBuffer, 16);
-    ctx->account_index = p1;
     memmove(ctx->payee, &dataBuffer[24], sizeof(ctx->payee));
     ctx->memo = U8LE(dataBuffer, 24+SIZEOF_B58_KEY);
+    return save_account_path(p1, dataBuffer, dataLength, 24+SIZEOF_B58_KEY+8, &ctx->path);
 }
 
-void save_stake_validator_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, __attribute__((unused)) uint16_t dataLength, stakeValidatorContext_t *ctx) {
+bool save_stake_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, stakeValidatorContext_t *ctx) {
+    if (p2 & P2_REQUEST_COMPACT) {
+        return save_stake_validator_compact(p1, dataBuffer, dataLength, ctx);
+    }
     ctx->stake = U8LE(dataBuffer, 0);
     ctx->fee  = U8LE(dataBuffer, 8);
-    ctx->account_index = p1;
     memmove(ctx->address, &dataBuffer[16], sizeof(ctx->address));
+    return save_account_path(p1, dataBuffer, dataLength, 16+SIZEOF_B58_KEY, &ctx->path);
 }
 
-void save_transfer_validator_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, __attribute__((unused)) uint16_t dataLength, transferValidatorContext_t *ctx) {
+bool save_transfer_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, transferValidatorContext_t *ctx) {
+    if (p2 & P2_REQUEST_COMPACT) {
+        return save_transfer_validator_compact(p1, dataBuffer, dataLength, ctx);
+    }
+    const uint16_t len = 24+4*SIZEOF_B58_KEY;
     ctx->stake_amount = U8LE(dataBuffer, 0);
     ctx->payment_amount  = U8LE(dataBuffer, 8);
     ctx->fee = U8LE(dataBuffer, 16);
-    ctx->account_index = p1;
     memmove(ctx->new_owner, &dataBuffer[24], sizeof(ctx->new_owner));
     memmove(ctx->old_owner, &dataBuffer[24+SIZEOF_B58_KEY], sizeof(ctx->old_owner));
     memmove(ctx->new_address, &dataBuffer[24+2*SIZEOF_B58_KEY], sizeof(ctx->new_address));
     memmove(ctx->old_address, &dataBuffer[24+3*SIZEOF_B58_KEY], sizeof(ctx->old_address));
+    ctx->both_owners = (p2 == P2_TRANSFER_VALIDATOR_BOTH_OWNERS);
+    memset(&ctx->new_owner_path, 0, sizeof(ctx->new_owner_path));
+    if (!ctx->both_owners) {
+        return save_account_path(p1, dataBuffer, dataLength, len, &ctx->path);
+    }
+    return save_account_paths(p1, dataBuffer, dataLength, len, &ctx->path, &ctx->new_owner_path);
 }
 
-void save_unstake_validator_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, __attribute__((unused)) uint16_t dataLength, unstakeValidatorContext_t *ctx) {
+bool save_unstake_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, unstakeValidatorContext_t *ctx) {
+    if (p2 & P2_REQUEST_COMPACT) {
+        return save_unstake_validator_compact(p1, dataBuffer, dataLength, ctx);
+    }
     ctx->stake_amount = U8LE(dataBuffer, 0);
     ctx->stake_release_height = U8LE(dataBuffer, 8);
     ctx->fee  = U8LE(dataBuffer, 16);
-    ctx->account_index = p1;
     memmove(ctx->address, &dataBuffer[24], sizeof(ctx->address));
+    return save_account_path(p1, dataBuffer, dataLength, 24+SIZEOF_B58_KEY, &ctx->path);
 }
 
-void save_burn_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, __attribute__((unused)) uint16_t dataLength, burnContext_t *ctx) {
+bool save_burn_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, burnContext_t *ctx) {
+    if (p2 & P2_REQUEST_COMPACT) {
+        return save_burn_compact(p1, dataBuffer, dataLength, ctx);
+    }
     ctx->amount = U8LE(dataBuffer, 0);
     ctx->fee = U8LE(dataBuffer, 8);
     ctx->nonce = U8LE(dataBuffer, 16);
     ctx->memo = U8LE(dataBuffer, 24);
-    ctx->account_index = p1;
     memmove(ctx->payee, &dataBuffer[32], sizeof(ctx->payee));
+    return save_account_path(p1, dataBuffer, dataLength, 32+SIZEOF_B58_KEY, &ctx->path);
 }
 
-void save_transfer_sec_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, __attribute__((unused)) uint16_t dataLength, transferSecContext_t *ctx) {
+bool save_transfer_sec_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, transferSecContext_t *ctx) {
+    if (p2 & P2_REQUEST_COMPACT) {
+        return save_transfer_sec_compact(p1, dataBuffer, dataLength, ctx);
+    }
     ctx->amount = U8LE(dataBuffer, 0);
     ctx->fee = U8LE(dataBuffer, 8);
     ctx->nonce = U8LE(dataBuffer, 16);
-    ctx->account_index = p1;
     memmove(ctx->payee, &dataBuffer[24], sizeof(ctx->payee));
+    return save_account_path(p1, dataBuffer, dataLength, 24+SIZEOF_B58_KEY, &ctx->path);
 }
 
+void save_address_book_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, addressBookContext_t *ctx) {
+    uint16_t label_len = 0;
+    if (dataLength > SIZEOF_B58_KEY) {
+        label_len = dataLength - SIZEOF_B58_KEY;
+    }
+    if (label_len > ADDRESS_BOOK_LABEL_LEN - 1) {
+        label_len = ADDRESS_BOOK_LABEL_LEN - 1;
+    }
+    ctx->operation = p1;
+    memmove(ctx->entry.key, dataBuffer, sizeof(ctx->entry.key));
+    memset(ctx->entry.label, 0, sizeof(ctx->entry.label));
+    memmove(ctx->entry.label, &dataBuffer[SIZEOF_B58_KEY], label_len);
+}
+
+// The batch request carries the account in P2, since P1 selects the step.
+// 'count' is 2 bytes long, the nonces of the run start at 'first_nonce',
+// and the digest of the entries comes last of the common fields.
+// A run of state channel opens has the blocks they expire within next.
+bool save_batch_context(__attribute__((unused)) uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, batchContext_t *ctx) {
+    ctx->type = dataBuffer[0];
+    ctx->first_nonce = U8LE(dataBuffer, 1);
+    ctx->count = dataBuffer[9] | (dataBuffer[10] << 8);
+    ctx->total = U8LE(dataBuffer, 11);
+    ctx->fee = U8LE(dataBuffer, 19);
+    ctx->last_nonce = ctx->first_nonce + ctx->count - 1;
+    memmove(ctx->entries_digest, &dataBuffer[27], sizeof(ctx->entries_digest));
+    ctx->expire_within = 0;
+    ctx->oui = 0;
+    memset(&ctx->oui_owner_path, 0, sizeof(ctx->oui_owner_path));
+    switch (ctx->type) {
+    case BATCH_TYPE_STATE_CHANNEL_OPEN:
+        if (dataLength < SIZEOF_BATCH_CHANNEL_CONTEXT) {
+            return false;
+        }
+        ctx->expire_within = U8LE(dataBuffer, SIZEOF_BATCH_CONTEXT);
+        return save_account_path(p2, dataBuffer, dataLength, SIZEOF_BATCH_CHANNEL_CONTEXT, &ctx->path);
+    case BATCH_TYPE_UPDATE_GATEWAY_OUI:
+        if (dataLength < SIZEOF_BATCH_GATEWAY_CONTEXT) {
+            return false;
+        }
+        ctx->oui = U8LE(dataBuffer, SIZEOF_BATCH_CONTEXT);
+        return save_account_paths(p2, dataBuffer, dataLength, SIZEOF_BATCH_GATEWAY_CONTEXT, &ctx->path, &ctx->oui_owner_path);
+    default:
+        return save_account_path(p2, dataBuffer, dataLength, SIZEOF_BATCH_CONTEXT, &ctx->path);
+    }
+}
+
+void save_batch_entry(const uint8_t *dataBuffer, batchEntry_t *entry) {
+    entry->amount = U8LE(dataBuffer, 0);
+    entry->memo = U8LE(dataBuffer, 8);
+    memmove(entry->payee, &dataBuffer[16], sizeof(entry->payee));
+}
+
+void save_batch_channel_entry(const uint8_t *dataBuffer, batchEntry_t *entry) {
+    entry->oui = U8LE(dataBuffer, 0);
+    entry->amount = U8LE(dataBuffer, 8);
+    entry->id_len = dataBuffer[16];
+    memmove(entry->id, &dataBuffer[17], sizeof(entry->id));
+}
 
+void save_batch_gateway_entry(const uint8_t *dataBuffer, batchEntry_t *entry) {
+    memmove(entry->payee, dataBuffer, sizeof(entry->payee));
+    entry->nonce = U8LE(dataBuffer, SIZEOF_B58_KEY);
+    entry->amount = 0;
+}
 
+bool save_update_gateway_oui_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, updateGatewayOuiContext_t *ctx) {
+    if (dataLength < SIZEOF_UPDATE_GATEWAY_OUI_REQUEST) {
+        return false;
+    }
+    ctx->oui = U8LE(dataBuffer, 0);
+    ctx->nonce = U8LE(dataBuffer, 8);
+    ctx->fee = U8LE(dataBuffer, 16);
+    memmove(ctx->gateway, &dataBuffer[24], sizeof(ctx->gateway));
+    return save_account_paths(p1, dataBuffer, dataLength, SIZEOF_UPDATE_GATEWAY_OUI_REQUEST, &ctx->path, &ctx->oui_owner_path);
+}
+
+void save_batch_create_htlc_entry(const uint8_t *dataBuffer, batchEntry_t *entry) {
+    entry->amount = U8LE(dataBuffer, 0);
+    entry->timelock = U8LE(dataBuffer, 8);
+    memmove(entry->payee, &dataBuffer[16], sizeof(entry->payee));
+    memmove(entry->address, &dataBuffer[16 + SIZEOF_B58_KEY], sizeof(entry->address));
+    memmove(entry->hashlock, &dataBuffer[16 + 2 * SIZEOF_B58_KEY], sizeof(entry->hashlock));
+}
+
+void save_batch_redeem_htlc_entry(const uint8_t *dataBuffer, batchEntry_t *entry) {
+    memmove(entry->address, dataBuffer, sizeof(entry->address));
+    memmove(entry->hashlock, &dataBuffer[SIZEOF_B58_KEY], sizeof(entry->hashlock));
+    entry->preimage_len = dataBuffer[SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN];
+    memmove(entry->preimage, &dataBuffer[SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN + 1], sizeof(entry->preimage));
+    entry->amount = 0;
+}
+
+bool save_create_htlc_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, createHtlcContext_t *ctx) {
+    if (dataLength < SIZEOF_CREATE_HTLC_REQUEST) {
+        return false;
+    }
+    ctx->amount = U8LE(dataBuffer, 0);
+    ctx->fee = U8LE(dataBuffer, 8);
+    ctx->nonce = U8LE(dataBuffer, 16);
+    ctx->timelock = U8LE(dataBuffer, 24);
+    memmove(ctx->payee, &dataBuffer[32], sizeof(ctx->payee));
+    memmove(ctx->address, &dataBuffer[32 + SIZEOF_B58_KEY], sizeof(ctx->address));
+    memmove(ctx->hashlock, &dataBuffer[32 + 2 * SIZEOF_B58_KEY], sizeof(ctx->hashlock));
+    return save_account_path(p1, dataBuffer, dataLength, SIZEOF_CREATE_HTLC_REQUEST, &ctx->path);
+}
+
+// The preimage comes last, after its length.
+bool save_redeem_htlc_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, redeemHtlcContext_t *ctx) {
+    uint16_t len = 8 + SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN + 1;
+    if (dataLength < len) {
+        return false;
+    }
+    ctx->fee = U8LE(dataBuffer, 0);
+    memmove(ctx->address, &dataBuffer[8], sizeof(ctx->address));
+    memmove(ctx->hashlock, &dataBuffer[8 + SIZEOF_B58_KEY], sizeof(ctx->hashlock));
+    ctx->preimage_len = dataBuffer[len - 1];
+    if (ctx->preimage_len > HTLC_PREIMAGE_MAX || dataLength < len + ctx->preimage_len) {
+        return false;
+    }
+    memmove(ctx->preimage, &dataBuffer[len], ctx->preimage_len);
+    len += ctx->preimage_len;
+    return save_account_path(p1, dataBuffer, dataLength, len, &ctx->path);
+}
+
+// The state channel id comes last, after its length.
+bool save_state_channel_open_context(uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, stateChannelOpenContext_t *ctx) {
+    uint16_t len = 41;
+    if (dataLength < len) {
+        return false;
+    }
+    ctx->amount = U8LE(dataBuffer, 0);
+    ctx->expire_within = U8LE(dataBuffer, 8);
+    ctx->oui = U8LE(dataBuffer, 16);
+    ctx->nonce = U8LE(dataBuffer, 24);
+    ctx->fee = U8LE(dataBuffer, 32);
+    ctx->id_len = dataBuffer[40];
+    if (ctx->id_len > STATE_CHANNEL_ID_MAX || dataLength < len + ctx->id_len) {
+        return false;
+    }
+    memmove(ctx->id, &dataBuffer[len], ctx->id_len);
+    len += ctx->id_len;
+    return save_account_path(p1, dataBuffer, dataLength, len, &ctx->path);
+}
+
+// The oui_v1 request has two variable parts: the router addresses and the
+// filter, each after its length.
+bool save_oui_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, ouiContext_t *ctx) {
+    uint16_t len = 28 + SIZEOF_B58_KEY;
+    if (dataLength < len + 1) {
+        return false;
+    }
+    ctx->oui = U8LE(dataBuffer, 0);
+    ctx->staking_fee = U8LE(dataBuffer, 8);
+    ctx->fee = U8LE(dataBuffer, 16);
+    ctx->requested_subnet_size = U4LE(dataBuffer, 24);
+    memmove(ctx->payer, &dataBuffer[28], sizeof(ctx->payer));
+    ctx->address_count = dataBuffer[len++];
+    if (ctx->address_count > OUI_ADDRESSES_MAX || dataLength < len + ctx->address_count * SIZEOF_B58_KEY + 1) {
+        return false;
+    }
+    memmove(ctx->addresses, &dataBuffer[len], ctx->address_count * SIZEOF_B58_KEY);
+    len += ctx->address_count * SIZEOF_B58_KEY;
+    ctx->filter_len = dataBuffer[len++];
+    if (ctx->filter_len > OUI_FILTER_MAX || dataLength < len + ctx->filter_len) {
+        return false;
+    }
+    memmove(ctx->filter, &dataBuffer[len], ctx->filter_len);
+    len += ctx->filter_len;
+
+    ctx->both_signers = (p2 == P2_OUI_OWNER_AND_PAYER);
+    memset(&ctx->payer_path, 0, sizeof(ctx->payer_path));
+    if (!ctx->both_signers) {
+        return save_account_path(p1, dataBuffer, dataLength, len, &ctx->path);
+    }
+    return save_account_paths(p1, dataBuffer, dataLength, len, &ctx->path, &ctx->payer_path);
+}
+
+// The routing request carries the account in P2, since P1 selects the step.
+// The length of its update part depends on the kind of update, so each part
+// is checked before it is read; whether the values make sense is left to
+// the handler.
+bool save_routing_context(__attribute__((unused)) uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, routingContext_t *ctx) {
+    uint16_t len = SIZEOF_ROUTING_REQUEST;
+    memset(ctx, 0, sizeof(*ctx));
+    if (dataLength < len) {
+        return false;
+    }
+    ctx->oui = U4LE(dataBuffer, 0);
+    ctx->fee = U8LE(dataBuffer, 4);
+    ctx->nonce = U8LE(dataBuffer, 12);
+    ctx->staking_fee = U8LE(dataBuffer, 20);
+    ctx->update = dataBuffer[28];
+
+    switch (ctx->update) {
+    case ROUTING_UPDATE_ROUTERS:
+        if (dataLength < len + 1) {
+            return false;
+        }
+        ctx->router_count = dataBuffer[len++];
+        if (ctx->router_count > ROUTING_ROUTERS_MAX || dataLength < len + ctx->router_count * SIZEOF_B58_KEY) {
+            return false;
+        }
+        memmove(ctx->routers, &dataBuffer[len], ctx->router_count * SIZEOF_B58_KEY);
+        len += ctx->router_count * SIZEOF_B58_KEY;
+        break;
+    case ROUTING_UPDATE_XOR:
+        if (dataLength < len + 4) {
+            return false;
+        }
+        ctx->xor_index = U4LE(dataBuffer, len);
+        len += 4;
+        // the filter length follows, as in ROUTING_NEW_XOR
+        // fall through
+    case ROUTING_NEW_XOR:
+        if (dataLength < len + 4) {
+            return false;
+        }
+        ctx->filter_length = U4LE(dataBuffer, len);
+        len += 4;
+        break;
+    case ROUTING_REQUEST_SUBNET:
+        if (dataLength < len + 4) {
+            return false;
+        }
+        ctx->subnet_size = U4LE(dataBuffer, len);
+        len += 4;
+        break;
+    default:
+        return false;
+    }
+    return save_account_path(p2, dataBuffer, dataLength, len, &ctx->path);
+}
+
+// The oracle policy request carries the account in P2, since P1 selects the
+// operation.
+bool save_oracle_policy_context(__attribute__((unused)) uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, oraclePolicyContext_t *ctx) {
+    if (dataLength < SIZEOF_ORACLE_POLICY_REQUEST) {
+        return false;
+    }
+    ctx->max_delta_bps = U4LE(dataBuffer, 0);
+    ctx->min_blocks = U4LE(dataBuffer, 4);
+    ctx->max_blocks = U4LE(dataBuffer, 8);
+    ctx->max_reports = U4LE(dataBuffer, 12);
+    ctx->reference_height = U8LE(dataBuffer, 16);
+    ctx->reference_price = U8LE(dataBuffer, 24);
+    return save_account_path(p2, dataBuffer, dataLength, SIZEOF_ORACLE_POLICY_REQUEST, &ctx->path);
+}
+
+// Reports are signed with the key of the policy, so they carry no path.
+bool save_price_oracle_context(__attribute__((unused)) uint8_t p1, __attribute__((unused)) uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, priceOracleContext_t *ctx) {
+    if (dataLength != SIZEOF_PRICE_ORACLE_REQUEST) {
+        return false;
+    }
+    ctx->price = U8LE(dataBuffer, 0);
+    ctx->block_height = U8LE(dataBuffer, 8);
+    return true;
+}
+
+bool save_account_path(uint8_t account, const uint8_t *dataBuffer, uint16_t dataLength, uint16_t len, accountPath_t *path) {
+    path->account = account;
+    path->change = 0;
+    path->address = 0;
+    if (dataLength == len) {
+        return true;
+    }
+    if (dataLength != len + 4 && dataLength != len + 12) {
+        return false;
+    }
+    path->account = U4LE(dataBuffer, len);
+    if (dataLength == len + 12) {
+        path->change = U4LE(dataBuffer, len + 4);
+        path->address = U4LE(dataBuffer, len + 8);
+    }
+    return path->account <= ACCOUNT_INDEX_MAX && path->change <= ACCOUNT_INDEX_MAX &&
+           path->address <= ACCOUNT_INDEX_MAX;
+}
+
+bool save_account_paths(uint8_t account, const uint8_t *dataBuffer, uint16_t dataLength, uint16_t len, accountPath_t *first, accountPath_t *second) {
+    uint16_t half = (dataLength - len) / 2;
+    if (dataLength <= len || dataLength != len + 2 * half) {
+        return false;
+    }
+    return save_account_path(account, dataBuffer, len + half, len, first) &&
+           save_account_path(account, &dataBuffer[half], len + half, len, second);
+}
@@ -3,25 +3,42 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "address_book.h"
+#include "key_set.h"
+
 #define SIZEOF_B58_KEY 34
 
+// accountPath_t selects the key at 44'/904'/account'/change'/address' (905'
+// on testnet). Ed25519 derivation only has hardened levels, so every index
+// is below 2^31.
+typedef struct {
+    uint32_t account;
+    uint32_t change;
+    uint32_t address;
+} accountPath_t;
+
+#define ACCOUNT_INDEX_MAX 0x7FFFFFFF
+
+// displayContext_t is the common prefix of every command context below. The
+// review screens only ever touch these fields, so they can display any
+// command's values through global.displayContext.
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+} displayContext_t;
+
 typedef struct {
     uint8_t displayIndex;
     uint8_t fullStr[55]; // variable length
-    // partialStr contains 12 characters of a longer string. This allows text
-    // to be scrolled.
-    uint8_t partialStr[13];
     uint8_t fullStr_len;
 } getPublicKeyContext_t;
 
 typedef struct {
     uint8_t displayIndex;
     uint8_t fullStr[55]; // variable length
-    // partialStr contains 12 characters of a longer string. This allows text
-    // to be scrolled.
-    uint8_t partialStr[13];
     uint8_t fullStr_len;
-    uint8_t account_index;
+    accountPath_t path;
     uint64_t amount;
     uint64_t nonce;
     uint64_t fee;
@@ -32,11 +49,8 @@ typedef struct {
 typedef struct {
     uint8_t displayIndex;
     uint8_t fullStr[55]; // variable length
-    // partialStr contains 12 characters of a longer string. This allows text
-    // to be scrolled.
-    uint8_t partialStr[13];
     uint8_t fullStr_len;
-    uint8_t account_index;
+    accountPath_t path;
     uint64_t stake;
     uint64_t nonce;
     uint64_t fee;
@@ -46,11 +60,8 @@ typedef struct {
 typedef struct {
     uint8_t displayIndex;
     uint8_t fullStr[55]; // variable length
-    // partialStr contains 12 characters of a longer string. This allows text
-    // to be scrolled.
-    uint8_t partialStr[13];
     uint8_t fullStr_len;
-    uint8_t account_index;
+    accountPath_t path;
     uint64_t stake_amount;
     uint64_t stake_release_height;
     uint64_t nonce;
@@ -61,11 +72,8 @@ typedef struct {
 typedef struct {
     uint8_t displayIndex;
     uint8_t fullStr[55]; // variable length
-    // partialStr contains 12 characters of a longer string. This allows text
-    // to be scrolled.
-    uint8_t partialStr[13];
     uint8_t fullStr_len;
-    uint8_t account_index;
+    accountPath_t path;
     uint64_t stake_amount;
     uint64_t payment_amount;
     uint64_t fee;
@@ -73,16 +81,51 @@ typedef struct {
     unsigned char new_owner[SIZEOF_B58_KEY];
     unsigned char old_address[SIZEOF_B58_KEY];
     unsigned char new_address[SIZEOF_B58_KEY];
+    // set when the request holds the keys of both owners: 'path' is the old
+    // owner's, and 'new_owner_path' the new owner's
+    bool both_owners;
+    accountPath_t new_owner_path;
 } transferValidatorContext_t;
 
+// With P2 set to P2_TRANSFER_VALIDATOR_BOTH_OWNERS, a transfer validator
+// request is followed by the path of the old owner and then the one of the
+// new owner, in either of the forms read by save_account_path.
+#define P2_TRANSFER_VALIDATOR_BOTH_OWNERS 0x01
+
+// With this bit set in P2, a sign request uses the compact encoding instead
+// of the fixed layouts: a version byte (REQUEST_COMPACT_VERSION), a byte of
+// REQUEST_HAS_* bits, then the fields of the request in order. Amounts,
+// fees, nonces and heights are unsigned LEB128 varints, as in protobuf, and
+// keys are 33 bytes long, without the leading 0 byte. The optional fields
+// come last, in the order of their bits, and are 0 when absent. Paths are
+// three varints: account, change and address. Without a path, the account
+// is P1 as in the fixed layouts.
+//
+//   payment, burn          amount, nonce, payee [fee] [memo] [path]
+//   transfer_sec           amount, nonce, payee [fee] [path]
+//   stake_validator        stake, address [fee] [path]
+//   unstake_validator      stake_amount, stake_release_height, address
+//                          [fee] [path]
+//   transfer_validator     stake_amount, payment_amount, new_owner,
+//                          old_owner, new_address, old_address [fee] [path]
+//                          [new owner path]
+//
+// A new owner path asks for both owner signatures, as
+// P2_TRANSFER_VALIDATOR_BOTH_OWNERS does, and requires the path of the old
+// owner.
+#define P2_REQUEST_COMPACT 0x80
+#define REQUEST_COMPACT_VERSION 0x02
+
+#define REQUEST_HAS_FEE 0x01
+#define REQUEST_HAS_MEMO 0x02
+#define REQUEST_HAS_PATH 0x04
+#define REQUEST_HAS_NEW_OWNER_PATH 0x08
+
 typedef struct {
     uint8_t displayIndex;
     uint8_t fullStr[55]; // variable length
-    // partialStr contains 12 characters of a longer string. This allows text
-    // to be scrolled.
-    uint8_t partialStr[13];
     uint8_t fullStr_len;
-    uint8_t account_index;
+    accountPath_t path;
     uint64_t amount;
     uint64_t nonce;
     uint64_t fee;
@@ -93,29 +136,383 @@ typedef struct {
 typedef struct {
     uint8_t displayIndex;
     uint8_t fullStr[55]; // variable length
-    // partialStr contains 12 characters of a longer string. This allows text
-    // to be scrolled.
-    uint8_t partialStr[13];
     uint8_t fullStr_len;
-    uint8_t account_index;
+    accountPath_t path;
     uint64_t amount;
     uint64_t nonce;
     uint64_t fee;
     unsigned char payee[34];
 } transferSecContext_t;
 
+// state channel ids are random, 32 bytes at most
+#define STATE_CHANNEL_ID_MAX 32
+
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    accountPath_t path;
+    uint64_t amount;
+    uint64_t expire_within;
+    uint64_t oui;
+    uint64_t nonce;
+    uint64_t fee;
+    uint8_t id_len;
+    unsigned char id[STATE_CHANNEL_ID_MAX];
+} stateChannelOpenContext_t;
+
+// An oui_v1 request holds the filter of the new OUI, which is small until
+// routing_v1 updates replace it.
+#define OUI_ADDRESSES_MAX 3
+#define OUI_FILTER_MAX 64
+
+// ouiContext_t holds an oui_v1 transaction owned by the device key of
+// 'path'. A payer of all zero bytes means the owner pays; otherwise the
+// payer signs too, here when 'both_signers' is set, with the key of
+// 'payer_path'.
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    accountPath_t path;
+    uint64_t oui;
+    uint64_t staking_fee;
+    uint64_t fee;
+    uint32_t requested_subnet_size;
+    unsigned char payer[SIZEOF_B58_KEY];
+    uint8_t address_count;
+    unsigned char addresses[OUI_ADDRESSES_MAX][SIZEOF_B58_KEY];
+    uint32_t filter_len;
+    unsigned char filter[OUI_FILTER_MAX];
+    bool both_signers;
+    accountPath_t payer_path;
+} ouiContext_t;
+
+// With P2 set to P2_OUI_OWNER_AND_PAYER, an oui_v1 request is followed by
+// the path of the owner and then the one of the payer, as for
+// P2_TRANSFER_VALIDATOR_BOTH_OWNERS.
+#define P2_OUI_OWNER_AND_PAYER 0x01
+
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    uint8_t operation;
+    addressBookEntry_t entry;
+} addressBookContext_t;
+
+// updateGatewayOuiContext_t holds an update_gateway_oui_v1 transaction,
+// signed by the owner of the gateway with the key of 'path' and by the
+// owner of the new OUI with the key of 'oui_owner_path'. Its nonce is the
+// gateway's, not an account's.
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    accountPath_t path;
+    accountPath_t oui_owner_path;
+    unsigned char gateway[SIZEOF_B58_KEY];
+    uint64_t oui;
+    uint64_t nonce;
+    uint64_t fee;
+} updateGatewayOuiContext_t;
+
+#define SIZEOF_UPDATE_GATEWAY_OUI_REQUEST (24 + SIZEOF_B58_KEY)
+
+// An HTLC is locked by the SHA-256 of a preimage, which its payee reveals
+// to redeem it before the block height of its timelock; afterwards, its
+// payer can take it back. Its address is a key that identifies it.
+#define HTLC_HASHLOCK_LEN 32
+#define HTLC_PREIMAGE_MAX 32
+
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    accountPath_t path;
+    uint64_t amount;
+    uint64_t fee;
+    uint64_t nonce;
+    uint64_t timelock;
+    unsigned char payee[SIZEOF_B58_KEY];
+    unsigned char address[SIZEOF_B58_KEY];
+    unsigned char hashlock[HTLC_HASHLOCK_LEN];
+} createHtlcContext_t;
+
+#define SIZEOF_CREATE_HTLC_REQUEST (32 + 2 * SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN)
+
+// redeemHtlcContext_t holds a redeem_htlc_v1 transaction. The hashlock is
+// not part of it, but the request carries it so that the device can catch
+// a preimage the host paired with the wrong HTLC. It is only as good as the
+// host that sends it.
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    accountPath_t path;
+    uint64_t fee;
+    unsigned char address[SIZEOF_B58_KEY];
+    unsigned char hashlock[HTLC_HASHLOCK_LEN];
+    uint8_t preimage_len;
+    unsigned char preimage[HTLC_PREIMAGE_MAX];
+} redeemHtlcContext_t;
+
+#define BATCH_DIGEST_LEN 32
 
-void save_payment_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, paymentContext_t *ctx);
-void save_stake_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, stakeValidatorContext_t *ctx);
-void save_transfer_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, transferValidatorContext_t *ctx);
-void save_unstake_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, unstakeValidatorContext_t *ctx);
-void save_burn_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, burnContext_t *ctx);
-void save_transfer_sec_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, transferSecContext_t *ctx);
+// batchContext_t holds the parameters of a run of payments, burns, state
+// channel opens or HTLC creations signed with consecutive nonces, of
+// gateways moved to one OUI, or of HTLC redemptions. It is kept outside of
+// commandContext, where each transaction of the run is built.
+typedef struct {
+    uint8_t type;
+    accountPath_t path;
+    uint64_t first_nonce;
+    uint64_t last_nonce;
+    uint64_t count;
+    uint64_t total;
+    uint64_t fee;
+    uint64_t expire_within;
+    // gateway moves are signed by two keys, and carry their own nonces
+    uint64_t oui;
+    accountPath_t oui_owner_path;
+    // the head of the chain of digests binding the entries of the run
+    unsigned char entries_digest[BATCH_DIGEST_LEN];
+} batchContext_t;
+
+#define BATCH_TYPE_PAYMENT 0x00
+#define BATCH_TYPE_BURN 0x01
+#define BATCH_TYPE_STATE_CHANNEL_OPEN 0x02
+#define BATCH_TYPE_UPDATE_GATEWAY_OUI 0x03
+#define BATCH_TYPE_CREATE_HTLC 0x04
+#define BATCH_TYPE_REDEEM_HTLC 0x05
+
+// The run starts with its type, first nonce, count, total and fee, then the
+// digest of its entries. On the wire, every entry is followed by the digest
+// of the entries after it: the digest of an entry is the SHA-256 of its
+// bytes followed by the digest of the next one, and the last entry is
+// followed by BATCH_DIGEST_LEN zero bytes. The digest of the first entry is
+// the one the run starts with.
+#define SIZEOF_BATCH_CONTEXT (27 + BATCH_DIGEST_LEN)
+#define SIZEOF_BATCH_ENTRY (16 + SIZEOF_B58_KEY)
+
+typedef struct {
+    uint64_t amount;
+    uint64_t memo;
+    unsigned char payee[SIZEOF_B58_KEY];
+    // state channel opens are for 'oui', and have their own id
+    uint64_t oui;
+    uint8_t id_len;
+    unsigned char id[STATE_CHANNEL_ID_MAX];
+    // gateway moves are of 'payee', with its own nonce
+    uint64_t nonce;
+    // HTLCs are created for 'payee', and redeemed with their preimage
+    uint64_t timelock;
+    unsigned char address[SIZEOF_B58_KEY];
+    unsigned char hashlock[HTLC_HASHLOCK_LEN];
+    uint8_t preimage_len;
+    unsigned char preimage[HTLC_PREIMAGE_MAX];
+} batchEntry_t;
+
+// signed transactions take up to 200 bytes each in the response, which
+// holds RESPONSE_CAPACITY bytes
+#define BATCH_ENTRIES_PER_APDU 2
+
+// A run of state channel opens takes the number of blocks they expire
+// within after the other batch fields, and its entries are the OUI and
+// amount (8 bytes each, little-endian), the length of the id and the id,
+// padded to STATE_CHANNEL_ID_MAX bytes.
+#define SIZEOF_BATCH_CHANNEL_CONTEXT (SIZEOF_BATCH_CONTEXT + 8)
+#define SIZEOF_BATCH_CHANNEL_ENTRY (17 + STATE_CHANNEL_ID_MAX)
+
+// A run of gateway moves takes the new OUI after the other batch fields, in
+// which 'first_nonce' and 'total' are 0, and ends with the paths of the
+// gateway owner and the OUI owner, as for save_account_paths. Its entries
+// are the gateway (34 bytes) and its nonce (8 bytes, little-endian).
+#define SIZEOF_BATCH_GATEWAY_CONTEXT (SIZEOF_BATCH_CONTEXT + 8)
+#define SIZEOF_BATCH_GATEWAY_ENTRY (SIZEOF_B58_KEY + 8)
+
+// A run of HTLC creations takes the usual batch fields, and its entries are
+// the amount and timelock (8 bytes each, little-endian), the payee, the
+// address and the hashlock. Redemptions have no nonce, so 'first_nonce' and
+// 'total' are 0; their entries are the address, the hashlock, the length of
+// the preimage and the preimage, padded to HTLC_PREIMAGE_MAX bytes.
+#define SIZEOF_BATCH_CREATE_HTLC_ENTRY (16 + 2 * SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN)
+#define SIZEOF_BATCH_REDEEM_HTLC_ENTRY (SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN + 1 + HTLC_PREIMAGE_MAX)
+
+// routingContext_t holds a routing_v1 transaction of an OUI owned by the
+// device key of 'path'. Its update is one of the ROUTING_* kinds below; the
+// XOR filters of the two filter updates are not held, but streamed after
+// the request, and only their length and SHA-256 digest are kept. It is
+// kept outside of commandContext, so that other commands sent while a
+// filter streams cannot change what is reviewed.
+typedef struct {
+    accountPath_t path;
+    uint32_t oui;
+    uint8_t update;
+    uint8_t router_count;
+    unsigned char routers[3][SIZEOF_B58_KEY];
+    uint32_t xor_index;
+    uint32_t subnet_size;
+    uint32_t filter_length;
+    uint32_t filter_received;
+    uint8_t filter_digest[32];
+    uint64_t fee;
+    uint64_t nonce;
+    uint64_t staking_fee;
+} routingContext_t;
+
+// oraclePolicyContext_t holds an oracle policy awaiting approval: the
+// bounds of the reports to sign without a review, and the reference they
+// start from (see oracle_policy.h). 'key' is the key of 'path', as shown.
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    accountPath_t path;
+    uint32_t max_delta_bps;
+    uint32_t min_blocks;
+    uint32_t max_blocks;
+    uint32_t max_reports;
+    uint64_t reference_height;
+    uint64_t reference_price;
+    unsigned char key[SIZEOF_B58_KEY];
+} oraclePolicyContext_t;
+
+#define SIZEOF_ORACLE_POLICY_REQUEST 32
+
+// priceOracleContext_t holds a price_oracle_v1 report, signed with the key
+// of the oracle policy, whose public key is kept with it.
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    accountPath_t path;
+    unsigned char public_key[32];
+    uint64_t price;
+    uint64_t block_height;
+} priceOracleContext_t;
+
+#define SIZEOF_PRICE_ORACLE_REQUEST 16
+
+#define ROUTING_UPDATE_ROUTERS 0x00
+#define ROUTING_NEW_XOR 0x01
+#define ROUTING_UPDATE_XOR 0x02
+#define ROUTING_REQUEST_SUBNET 0x03
+
+#define ROUTING_ROUTERS_MAX 3
+// an OUI has up to 5 filters, of 100 KB or less
+#define ROUTING_XOR_INDEX_MAX 4
+#define ROUTING_FILTER_MAX 102400
+
+// A routing request is the OUI (4 bytes, little-endian), fee, nonce and
+// staking fee (8 bytes each, little-endian) and the ROUTING_* kind of
+// update, followed by:
+//
+//   ROUTING_UPDATE_ROUTERS  the number of routers, then their keys
+//   ROUTING_NEW_XOR         the filter length (4 bytes)
+//   ROUTING_UPDATE_XOR      the filter index and length (4 bytes each)
+//   ROUTING_REQUEST_SUBNET  the subnet size (4 bytes)
+//
+// and by the key path, as read by save_account_path with P2 as the account.
+#define SIZEOF_ROUTING_REQUEST 29
+
+bool save_payment_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, paymentContext_t *ctx);
+bool save_stake_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, stakeValidatorContext_t *ctx);
+bool save_transfer_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, transferValidatorContext_t *ctx);
+bool save_unstake_validator_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, unstakeValidatorContext_t *ctx);
+bool save_burn_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, burnContext_t *ctx);
+bool save_transfer_sec_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, transferSecContext_t *ctx);
+void save_address_book_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, addressBookContext_t *ctx);
+bool save_batch_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, batchContext_t *ctx);
+void save_batch_entry(const uint8_t *dataBuffer, batchEntry_t *entry);
+void save_batch_channel_entry(const uint8_t *dataBuffer, batchEntry_t *entry);
+void save_batch_gateway_entry(const uint8_t *dataBuffer, batchEntry_t *entry);
+void save_batch_create_htlc_entry(const uint8_t *dataBuffer, batchEntry_t *entry);
+void save_batch_redeem_htlc_entry(const uint8_t *dataBuffer, batchEntry_t *entry);
+bool save_create_htlc_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, createHtlcContext_t *ctx);
+bool save_redeem_htlc_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, redeemHtlcContext_t *ctx);
+bool save_update_gateway_oui_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, updateGatewayOuiContext_t *ctx);
+bool save_state_channel_open_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, stateChannelOpenContext_t *ctx);
+bool save_oui_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, ouiContext_t *ctx);
+bool save_routing_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, routingContext_t *ctx);
+bool save_oracle_policy_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, oraclePolicyContext_t *ctx);
+bool save_price_oracle_context(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, priceOracleContext_t *ctx);
+
+// save_account_path reads the key path of a request whose other fields take
+// 'len' bytes. Older hosts send nothing more, and the account is 'account',
+// from P1 or P2. Newer ones append the account, or the account, change and
+// address indices, as 4-byte little-endian integers. It returns false if
+// the request has any other length, or an index is 2^31 or more. The
+// save_*_context functions above return its result.
+bool save_account_path(uint8_t account, const uint8_t *dataBuffer, uint16_t dataLength, uint16_t len, accountPath_t *path);
+
+// save_account_paths reads the two key paths that end a request signed by
+// two keys of the device. Both take the same form, so each takes half of
+// what follows the other fields; they are required.
+bool save_account_paths(uint8_t account, const uint8_t *dataBuffer, uint16_t dataLength, uint16_t len, accountPath_t *first, accountPath_t *second);
 
 // Each command has some state associated with it that sticks around for the
 // life of the command. A separate context_t struct should be defined for each
 // command.
+// verifyAddressesContext_t holds the candidate keys of a verifyAddresses run
+// (see verify_addresses.c). Any other command ends the run, so they share
+// commandContext with the rest.
+typedef struct {
+    uint8_t displayIndex;
+    uint8_t fullStr[55]; // variable length
+    uint8_t fullStr_len;
+    keySet_t keys;
+} verifyAddressesContext_t;
+
+// batchEntriesContext_t holds the entries of a signBatch command while they
+// are signed one after the other (see helium_batch.c), out of the stack and
+// of G_io_apdu_buffer, which each signature overwrites. Each entry is signed
+// from the context of its transaction, at the start of commandContext:
+// 'signing' keeps that room, so the entries are past it.
+typedef struct {
+    union {
+        paymentContext_t payment;
+        burnContext_t burn;
+        stateChannelOpenContext_t stateChannelOpen;
+        updateGatewayOuiContext_t updateGatewayOui;
+        createHtlcContext_t createHtlc;
+        redeemHtlcContext_t redeemHtlc;
+    } signing;
+    batchEntry_t entries[BATCH_ENTRIES_PER_APDU];
+} batchEntriesContext_t;
+
+// reviewSummaryContext_t holds the summary of a review in expert review mode
+// (see review_summary.h), which holds whole addresses and so outgrows
+// fullStr. It is kept past the context of whatever is under review, in room
+// that only a verifyAddresses run uses otherwise, and no review stays open
+// through one. The longest is that of a validator transfer signed by both
+// owners, with four addresses and the largest amounts and fee.
+#define REVIEW_SUMMARY_MAX 364
+
+typedef struct {
+    union {
+        paymentContext_t payment;
+        stakeValidatorContext_t stakeValidator;
+        transferValidatorContext_t transferValidator;
+        unstakeValidatorContext_t unstakeValidator;
+        burnContext_t burn;
+        transferSecContext_t transferSec;
+        stateChannelOpenContext_t stateChannelOpen;
+        ouiContext_t oui;
+        updateGatewayOuiContext_t updateGatewayOui;
+        createHtlcContext_t createHtlc;
+        redeemHtlcContext_t redeemHtlc;
+        addressBookContext_t addressBook;
+        oraclePolicyContext_t oraclePolicy;
+        priceOracleContext_t priceOracle;
+        batchEntriesContext_t batchEntries;
+    } reviewed;
+    uint16_t summary_len;
+    uint8_t summary[REVIEW_SUMMARY_MAX];
+} reviewSummaryContext_t;
+
 typedef union {
+    displayContext_t displayContext;
     getPublicKeyContext_t getPublicKeyContext;
     paymentContext_t paymentContext;
     stakeValidatorContext_t stakeValidatorContext;
@@ -123,6 +520,17 @@ typedef union {
     unstakeValidatorContext_t unstakeValidatorContext;
     burnContext_t burnContext;
     transferSecContext_t transferSecContext;
+    stateChannelOpenContext_t stateChannelOpenContext;
+    ouiContext_t ouiContext;
+    updateGatewayOuiContext_t updateGatewayOuiContext;
+    createHtlcContext_t createHtlcContext;
+    redeemHtlcContext_t redeemHtlcContext;
+    addressBookContext_t addressBookContext;
+    oraclePolicyContext_t oraclePolicyContext;
+    priceOracleContext_t priceOracleContext;
+    verifyAddressesContext_t verifyAddressesContext;
+    batchEntriesContext_t batchEntriesContext;
+    reviewSummaryContext_t reviewSummaryContext;
 } commandContext;
 
 extern commandContext global;
\ No newline at end of file
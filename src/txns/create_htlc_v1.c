@@ -0,0 +1,82 @@
+#include "helium.h"
+#include "pb.h"
+#include "pb_encode.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_create_htlc_v1.pb.h"
+#include "save_context.h"
+
+// encode_create_htlc_txn writes the transaction held in the context,
+// including 'signature' unless it is NULL.
+static void encode_create_htlc_txn(pb_ostream_t *ostream, const unsigned char *payer, const unsigned char *signature){
+    createHtlcContext_t * ctx = &global.createHtlcContext;
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_create_htlc_v1_payer_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)payer, SIZEOF_HELIUM_KEY);
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_create_htlc_v1_payee_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->payee[1], SIZEOF_HELIUM_KEY);
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_create_htlc_v1_address_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_create_htlc_v1_hashlock_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)ctx->hashlock, HTLC_HASHLOCK_LEN);
+
+    if(ctx->timelock) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_create_htlc_v1_timelock_tag);
+        txn_encode_varint(ostream, ctx->timelock);
+    }
+
+    if(ctx->amount) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_create_htlc_v1_amount_tag);
+        txn_encode_varint(ostream, ctx->amount);
+    }
+
+    if(ctx->fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_create_htlc_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
+    }
+
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_create_htlc_v1_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
+
+    if(ctx->nonce) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_create_htlc_v1_nonce_tag);
+        txn_encode_varint(ostream, ctx->nonce);
+    }
+}
+
+uint32_t size_helium_create_htlc_txn(void){
+    unsigned char payer[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_create_htlc_txn(&ostream, payer, signature);
+    return ostream.bytes_written;
+}
+
+uint32_t create_helium_create_htlc_txn(const accountPath_t *path){
+    pb_ostream_t ostream;
+
+    unsigned char payer[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    payer[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+    payer[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+    get_pubkey_bytes(path, &payer[1]);
+
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_create_htlc_txn(&ostream, payer, NULL);
+
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_create_htlc_txn(&ostream, payer, signature);
+
+    return ostream.bytes_written;
+}
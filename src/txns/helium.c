@@ -64,14 +64,11 @@ uint32_t pretty_print_hnt(uint8_t *dst, uint64_t n){
 #define INDEX 904
 #endif
 
-void derive_helium_public_key
-(uint32_t account, cx_ecfp_private_key_t *privateKey, cx_ecfp_public_key_t *publicKey) {
+static void derive_ed25519_key
+(const uint32_t *bip32Path, cx_ecfp_private_key_t *privateKey, cx_ecfp_public_key_t *publicKey) {
 	uint8_t keySeed[32];
 	static cx_ecfp_private_key_t pk;
 
-    // bip32 path for 44'/904'/n'/0'/0' for Mainnet
-    uint32_t bip32Path[] = {44 | 0x80000000, INDEX | 0x80000000, account | 0x80000000, 0x80000000, 0x80000000};
-
 	os_perso_derive_node_bip32_seed_key(HDW_ED25519_SLIP10, CX_CURVE_Ed25519, bip32Path, 5, keySeed, NULL, NULL, 0);
 
 	cx_ecfp_init_private_key(CX_CURVE_Ed25519, keySeed, sizeof(keySeed), &pk);
@@ -86,18 +83,49 @@ void derive_helium_public_key
 	memset(&pk, 0, sizeof(pk));
 }
 
+void derive_helium_public_key
+(const accountPath_t *path, cx_ecfp_private_key_t *privateKey, cx_ecfp_public_key_t *publicKey) {
+    // bip32 path for 44'/904'/account'/change'/address' for Mainnet
+    uint32_t bip32Path[] = {44 | 0x80000000, INDEX | 0x80000000, path->account | 0x80000000,
+                            path->change | 0x80000000, path->address | 0x80000000};
+	derive_ed25519_key(bip32Path, privateKey, publicKey);
+}
+
+// The device identity key lives under the SLIP-13 purpose, at
+// 13'/904'/0'/0'/0' for Mainnet, away from every account key.
+static void derive_identity_key(cx_ecfp_private_key_t *privateKey, cx_ecfp_public_key_t *publicKey) {
+    uint32_t bip32Path[] = {13 | 0x80000000, INDEX | 0x80000000, 0x80000000, 0x80000000, 0x80000000};
+	derive_ed25519_key(bip32Path, privateKey, publicKey);
+}
+
 #include "pb.h"
 #include <os_io_seproxyhal.h>
 #include "../ux/helium_ux.h"
 
 
-void sign_tx(uint8_t *dst, uint32_t account, const uint8_t *tx, uint16_t length) {
+void sign_tx(uint8_t *dst, const accountPath_t *path, const uint8_t *tx, uint16_t length) {
 	cx_ecfp_private_key_t privateKey;
-    derive_helium_public_key(account, &privateKey, NULL);
+    derive_helium_public_key(path, &privateKey, NULL);
 	cx_eddsa_sign(&privateKey, CX_RND_RFC6979 | CX_LAST, CX_SHA512, tx, length, NULL, 0, dst, 64, NULL);
 	memset(&privateKey, 0, sizeof(privateKey));
 }
 
+void sign_identity(uint8_t *dst, const uint8_t *msg, uint16_t length) {
+	cx_ecfp_private_key_t privateKey;
+	derive_identity_key(&privateKey, NULL);
+	cx_eddsa_sign(&privateKey, CX_RND_RFC6979 | CX_LAST, CX_SHA512, msg, length, NULL, 0, dst, 64, NULL);
+	memset(&privateKey, 0, sizeof(privateKey));
+}
+
+bool htlc_preimage_matches(const uint8_t *preimage, uint8_t len, const uint8_t *hashlock) {
+	cx_sha256_t hash;
+	uint8_t digest[32];
+
+	cx_sha256_init(&hash);
+	cx_hash(&hash.header, CX_LAST, preimage, len, digest, sizeof(digest));
+	return memcmp(digest, hashlock, sizeof(digest)) == 0;
+}
+
 void extract_pubkey_bytes(unsigned char *dst, cx_ecfp_public_key_t *publicKey) {
 	for (int i = 0; i < 32; i++) {
 		dst[i] = publicKey->W[64 - i];
@@ -195,12 +223,134 @@ int btchip_encode_base58(const unsigned char *in, size_t length,
   return 0;
 }
 
-void __attribute__ ((noinline)) get_pubkey_bytes(uint8_t account, uint8_t * out){
+void __attribute__ ((noinline)) get_pubkey_bytes(const accountPath_t *path, uint8_t * out){
+	cx_ecfp_public_key_t publicKey;
+    derive_helium_public_key(path, NULL, &publicKey);
+	extract_pubkey_bytes(out, &publicKey);
+}
+
+void __attribute__ ((noinline)) get_identity_pubkey_bytes(uint8_t * out){
 	cx_ecfp_public_key_t publicKey;
-    derive_helium_public_key(account, NULL, &publicKey);
+	derive_identity_key(NULL, &publicKey);
 	extract_pubkey_bytes(out, &publicKey);
 }
 
+// Ed25519 hashes the message twice: once for the nonce, once for the
+// challenge. A streamed message can only go through the second, so its
+// nonce is made from a seed instead, the way cx_ecfp_generate_pair makes a
+// key pair from any seed. Verifiers cannot tell the difference. The seed is
+// the hash of the secret prefix of the key, random bytes and the request the
+// message is built from, as in RFC 8032 with the randomness added: a weak
+// RNG alone neither reveals the nonce nor repeats it across transactions.
+// Scalars are big-endian here, as cx_math_* take them.
+static struct {
+	cx_sha512_t hash;
+	uint8_t r[32];
+	uint8_t R[32];
+	signStreamOwner_t owner;
+} stream;
+
+// the order of the Ed25519 base point
+static const uint8_t ED25519_L[32] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x14, 0xde, 0xf9, 0xde, 0xa2, 0xf7, 0x9c, 0xd6, 0x58, 0x12, 0x63, 0x1a, 0x5c, 0xf5, 0xd3, 0xed,
+};
+
+// ed25519_scalar writes the secret scalar of 'seed', reduced modulo L.
+static void ed25519_scalar(uint8_t *dst, const uint8_t *seed) {
+	cx_sha512_t hash;
+	uint8_t digest[64];
+
+	cx_sha512_init(&hash);
+	cx_hash(&hash.header, CX_LAST, seed, 32, digest, sizeof(digest));
+	digest[0] &= 0xF8;
+	digest[31] &= 0x7F;
+	digest[31] |= 0x40;
+	for (int i = 0; i < 32; i++) {
+		dst[i] = digest[31 - i];
+	}
+	cx_math_modm(dst, 32, ED25519_L, 32);
+	memset(digest, 0, sizeof(digest));
+}
+
+void sign_stream_start(signStreamOwner_t owner, const accountPath_t *path, const void *request, uint16_t length) {
+	uint8_t seed[64];
+	uint8_t key[32];
+	cx_ecfp_private_key_t privateKey;
+	cx_ecfp_public_key_t publicKey;
+
+	stream.owner = SIGN_STREAM_NONE;
+	derive_helium_public_key(path, &privateKey, &publicKey);
+	extract_pubkey_bytes(key, &publicKey);
+	// the prefix is the second half of the hash of the private key
+	cx_sha512_init(&stream.hash);
+	cx_hash(&stream.hash.header, CX_LAST, privateKey.d, 32, seed, sizeof(seed));
+	memset(&privateKey, 0, sizeof(privateKey));
+	cx_sha512_init(&stream.hash);
+	cx_hash(&stream.hash.header, 0, &seed[32], 32, NULL, 0);
+	cx_rng(seed, 32);
+	cx_hash(&stream.hash.header, 0, seed, 32, NULL, 0);
+	cx_hash(&stream.hash.header, CX_LAST, request, length, seed, sizeof(seed));
+
+	cx_ecfp_init_private_key(CX_CURVE_Ed25519, seed, 32, &privateKey);
+	cx_ecfp_init_public_key(CX_CURVE_Ed25519, NULL, 0, &publicKey);
+	cx_ecfp_generate_pair(CX_CURVE_Ed25519, &publicKey, &privateKey, 1);
+	extract_pubkey_bytes(stream.R, &publicKey);
+	ed25519_scalar(stream.r, seed);
+	memset(seed, 0, sizeof(seed));
+	memset(&privateKey, 0, sizeof(privateKey));
+
+	cx_sha512_init(&stream.hash);
+	cx_hash(&stream.hash.header, 0, stream.R, sizeof(stream.R), NULL, 0);
+	cx_hash(&stream.hash.header, 0, key, sizeof(key), NULL, 0);
+	stream.owner = owner;
+}
+
+void sign_stream_update(signStreamOwner_t owner, const uint8_t *data, uint16_t length) {
+	if (owner == SIGN_STREAM_NONE || stream.owner != owner) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	cx_hash(&stream.hash.header, 0, data, length, NULL, 0);
+}
+
+void sign_stream_finish(signStreamOwner_t owner, uint8_t *dst, const accountPath_t *path) {
+	uint8_t k[64];
+	uint8_t a[32];
+	uint8_t s[32];
+	cx_ecfp_private_key_t privateKey;
+
+	// without a nonce, the signature would give the key away
+	if (owner == SIGN_STREAM_NONE || stream.owner != owner) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	// the challenge is little-endian
+	cx_hash(&stream.hash.header, CX_LAST, NULL, 0, k, sizeof(k));
+	for (int i = 0; i < 32; i++) {
+		uint8_t b = k[i];
+		k[i] = k[63 - i];
+		k[63 - i] = b;
+	}
+	cx_math_modm(k, sizeof(k), ED25519_L, 32);
+
+	derive_helium_public_key(path, &privateKey, NULL);
+	ed25519_scalar(a, privateKey.d);
+	memset(&privateKey, 0, sizeof(privateKey));
+
+	// S = r + k * a mod L, big-endian in the first half of 'k' (the reduced
+	// challenge is in its second half); the signature is R then S,
+	// little-endian.
+	cx_math_multm(s, &k[32], a, ED25519_L, 32);
+	cx_math_addm(k, s, stream.r, ED25519_L, 32);
+	memmove(dst, stream.R, 32);
+	for (int i = 0; i < 32; i++) {
+		dst[32 + i] = k[31 - i];
+	}
+	memset(a, 0, sizeof(a));
+	memset(s, 0, sizeof(s));
+	memset(k, 0, sizeof(k));
+	memset(&stream, 0, sizeof(stream));
+}
+
 static const unsigned char base64_table[65] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
@@ -226,3 +376,23 @@ int u64_to_base64(uint8_t *dst, uint64_t n){
     *dst++ = '\0';
     return OUTPUT_LEN;
 }
+
+int bytes_to_base64(uint8_t *dst, const uint8_t *in, uint16_t len){
+    int written = 0;
+
+    for (uint16_t i = 0; i < len; i += 3) {
+        uint32_t n = in[i] << 16;
+        if (i + 1 < len) {
+            n |= in[i + 1] << 8;
+        }
+        if (i + 2 < len) {
+            n |= in[i + 2];
+        }
+        dst[written++] = base64_table[(n >> 18) & 0x3f];
+        dst[written++] = base64_table[(n >> 12) & 0x3f];
+        dst[written++] = i + 1 < len ? base64_table[(n >> 6) & 0x3f] : '=';
+        dst[written++] = i + 2 < len ? base64_table[n & 0x3f] : '=';
+    }
+    dst[written] = '\0';
+    return written;
+}
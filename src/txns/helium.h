@@ -2,12 +2,16 @@
 #include <stdint.h>
 #include <os.h>
 #include <cx.h>
+#include "save_context.h"
 
 // exception codes
 #define SW_DEVELOPER_ERR 0x6B00
 #define SW_INVALID_PARAM 0x6B01
 #define SW_IMPROPER_INIT 0x6B02
+#define SW_ADDRESS_BOOK_FULL 0x6B03
+#define SW_POLICY_VIOLATION 0x6B04
 #define SW_USER_REJECTED 0x6985
+#define SW_MORE_DATA     0x6100
 #define SW_OK            0x9000
 
 // bin2hex converts binary to hex and appends a final NUL byte.
@@ -21,9 +25,35 @@ int bin2dec(uint8_t *dst, uint64_t n);
 // final NUL byte. It returns the length of the string.
 int u64_to_base64(uint8_t *dst, uint64_t n);
 
+// bytes_to_base64 renders 'len' bytes in padded Base64 and appends a final
+// NUL byte. It returns the length of the string.
+int bytes_to_base64(uint8_t *dst, const uint8_t *in, uint16_t len);
+
 uint32_t pretty_print_hnt(uint8_t *dst, uint64_t n);
 
-void sign_tx(uint8_t *dst, uint32_t account, const uint8_t *tx, uint16_t length);
+void sign_tx(uint8_t *dst, const accountPath_t *path, const uint8_t *tx, uint16_t length);
+
+// The sign_stream_* functions sign a transaction passed in pieces, such as
+// one carrying a routing filter, which is never held as a whole. Only one
+// stream is signed at a time: sign_stream_start begins it for the key of
+// 'path', and sign_stream_finish writes its 64-byte signature to 'dst'. The
+// same path must be given to both. 'request' is the request the transaction
+// is built from, 'length' bytes long, which the nonce is derived from.
+//
+// Each stream belongs to the 'owner' that started it, and a new one drops
+// the previous one. Both sign_stream_update and sign_stream_finish throw
+// SW_IMPROPER_INIT unless 'owner' has a stream going, which
+// sign_stream_finish ends, so that a stream cut short by another one is
+// never finished.
+typedef enum {
+    SIGN_STREAM_NONE,
+    SIGN_STREAM_ROUTING,
+    SIGN_STREAM_OUI,
+} signStreamOwner_t;
+
+void sign_stream_start(signStreamOwner_t owner, const accountPath_t *path, const void *request, uint16_t length);
+void sign_stream_update(signStreamOwner_t owner, const uint8_t *data, uint16_t length);
+void sign_stream_finish(signStreamOwner_t owner, uint8_t *dst, const accountPath_t *path);
 
 typedef struct transaction_arg_t {
     uint8_t * buf;
@@ -37,12 +67,50 @@ typedef struct transaction_arg_t {
 extern bool sign_transaction;
 extern uint16_t txn_length;
 
-uint32_t create_helium_pay_txn(uint8_t account_index);
-uint32_t create_helium_stake_txn(uint8_t account);
-uint32_t create_helium_transfer_validator_txn(uint8_t account);
-uint32_t create_helium_unstake_txn(uint8_t account);
-uint32_t create_helium_burn_txn(uint8_t account);
-uint32_t create_helium_transfer_sec(uint8_t account);
+uint32_t create_helium_pay_txn(const accountPath_t *path);
+uint32_t create_helium_stake_txn(const accountPath_t *path);
+uint32_t create_helium_transfer_validator_txn(const accountPath_t *path);
+uint32_t create_helium_unstake_txn(const accountPath_t *path);
+uint32_t create_helium_burn_txn(const accountPath_t *path);
+uint32_t create_helium_transfer_sec(const accountPath_t *path);
+uint32_t create_helium_state_channel_open_txn(const accountPath_t *path);
+uint32_t create_helium_oui_txn(const accountPath_t *path);
+uint32_t create_helium_price_oracle_txn(const accountPath_t *path);
+uint32_t create_helium_update_gateway_oui_txn(const accountPath_t *path);
+uint32_t create_helium_create_htlc_txn(const accountPath_t *path);
+uint32_t create_helium_redeem_htlc_txn(const accountPath_t *path);
+
+// The size_helium_* functions return the size the fee of the matching
+// transaction is based on: encoded without a fee, which must be 0 in the
+// context, and with zeroed signatures.
+uint32_t size_helium_pay_txn(void);
+uint32_t size_helium_stake_txn(void);
+uint32_t size_helium_transfer_validator_txn(void);
+uint32_t size_helium_unstake_txn(void);
+uint32_t size_helium_burn_txn(void);
+uint32_t size_helium_transfer_sec(void);
+uint32_t size_helium_state_channel_open_txn(void);
+uint32_t size_helium_oui_txn(void);
+uint32_t size_helium_update_gateway_oui_txn(void);
+uint32_t size_helium_create_htlc_txn(void);
+uint32_t size_helium_redeem_htlc_txn(void);
+
+// htlc_preimage_matches returns whether the SHA-256 of the 'len' bytes of
+// 'preimage' is 'hashlock'. Both come from the host, and a redeem does not
+// carry the hashlock, so this only catches a host pairing the wrong
+// preimage with an HTLC; it does not prove the redeem unlocks it.
+bool htlc_preimage_matches(const uint8_t *preimage, uint8_t len, const uint8_t *hashlock);
+
+// A routing_v1 transaction is signed as it streams: start_helium_routing_txn
+// goes up to the filter, stream_helium_routing_filter takes it in pieces,
+// counting them in filter_received, and goes on to the end after the last
+// one, and create_helium_routing_txn leaves the signature alone in
+// G_io_apdu_buffer; the host already holds the rest. Updates without a
+// filter are complete after the start.
+void start_helium_routing_txn(const routingContext_t *ctx);
+void stream_helium_routing_filter(routingContext_t *ctx, const uint8_t *filter, uint16_t length);
+uint32_t create_helium_routing_txn(const routingContext_t *ctx);
+uint32_t size_helium_routing_txn(const routingContext_t *ctx);
 
 #define SIZE_OF_PUB_KEY_BIN 	32
 #define SIZE_OF_SHA_CHECKSUM 	4
@@ -53,10 +121,73 @@ uint32_t create_helium_transfer_sec(uint8_t account);
 #define NETTYPE_MAIN 0x00
 #define NETTYPE_TEST 0x10
 
+// instruction codes of the APDU protocol
+#define INS_GET_VERSION    0x01
+#define INS_GET_PUBLIC_KEY 0x02
+#define INS_SIGN_PAYMENT_TXN   0x08
+#define INS_SIGN_STAKE_VALIDATOR_TXN   0x09
+#define INS_SIGN_TRANSFER_VALIDATOR_TXN   0x0A
+#define INS_SIGN_UNSTAKE_VALIDATOR_TXN   0x0B
+#define INS_SIGN_BURN_TXN   0x0C
+#define INS_SIGN_TRANSFER_SEC_TXN   0x0D
+#define INS_ADDRESS_BOOK   0x0E
+#define INS_SET_FEE_PARAMS   0x0F
+#define INS_ESTIMATE_FEE   0x10
+#define INS_SIGN_BATCH   0x11
+#define INS_VERIFY_ADDRESSES   0x12
+#define INS_GET_KEY_MANIFEST   0x13
+#define INS_SIGN_ROUTING_TXN   0x14
+#define INS_SIGN_STATE_CHANNEL_OPEN_TXN   0x15
+#define INS_SIGN_OUI_TXN   0x16
+#define INS_ORACLE_POLICY   0x17
+#define INS_SIGN_PRICE_ORACLE_TXN   0x18
+#define INS_SIGN_UPDATE_GATEWAY_OUI_TXN   0x19
+#define INS_SIGN_CREATE_HTLC_TXN   0x1A
+#define INS_SIGN_REDEEM_HTLC_TXN   0x1B
+#define INS_GET_RESPONSE   0xC0
+
 #define P1_PUBKEY_DISPLAY_ON	0x01
 #define P1_PUBKEY_DISPLAY_OFF 	0x00
 
-void get_pubkey_bytes(uint8_t account_index, uint8_t * out);
+#define P1_BATCH_START	0x00
+#define P1_BATCH_ENTRIES	0x01
+#define P1_BATCH_FINISH	0x02
+
+#define P1_ADDRESS_BOOK_ADD	0x00
+#define P1_ADDRESS_BOOK_REMOVE	0x01
+
+#define P1_VERIFY_FIRST_KEYS	0x00
+#define P1_VERIFY_MORE_KEYS	0x01
+#define P1_VERIFY_SEARCH	0x02
+
+#define VERIFY_KEYS_PER_APDU	7
+// each account takes a key derivation, so a search is kept to a few seconds
+#define VERIFY_SEARCH_MAX	32
+
+#define P1_MANIFEST_IDENTITY	0x00
+#define P1_MANIFEST_KEYS	0x01
+
+// a manifest of MANIFEST_MAX_KEYS keys and its signature fill the response
+#define MANIFEST_MAX_KEYS	12
+
+#define P1_ROUTING_START	0x00
+#define P1_ROUTING_FILTER	0x01
+
+#define P1_ORACLE_POLICY_SET	0x00
+#define P1_ORACLE_POLICY_DISABLE	0x01
+#define P1_ORACLE_POLICY_GET	0x02
+
+// address_book_label returns the label under which 'key' (34 bytes, as in
+// sign requests) was trusted on this device, or NULL.
+const char *address_book_label(const unsigned char *key);
+
+void get_pubkey_bytes(const accountPath_t *path, uint8_t * out);
+
+// The device identity key signs what the device vouches for outside of
+// transactions, such as key manifests. It is derived at 13'/904'/0'/0'/0'
+// (905' on testnet), so it is never the key of an account.
+void get_identity_pubkey_bytes(uint8_t * out);
+void sign_identity(uint8_t *dst, const uint8_t *msg, uint16_t length);
 #define MAX_ENC_INPUT_SIZE 120
 
 int btchip_encode_base58(const unsigned char *in, size_t length,
@@ -0,0 +1,125 @@
+#include "helium.h"
+#include "pb.h"
+#include "pb_encode.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_oui_v1.pb.h"
+#include "save_context.h"
+#include "response.h"
+
+static const unsigned char no_payer[SIZEOF_B58_KEY] = {0};
+
+static bool has_payer(const ouiContext_t *ctx){
+    return memcmp(ctx->payer, no_payer, sizeof(no_payer)) != 0;
+}
+
+// encode_oui_txn writes the transaction held in the context, including each
+// signature that is not NULL.
+static void encode_oui_txn(pb_ostream_t *ostream, const unsigned char *owner, const unsigned char *owner_signature, const unsigned char *payer_signature){
+    ouiContext_t * ctx = &global.ouiContext;
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_oui_v1_owner_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)owner, SIZEOF_HELIUM_KEY);
+
+    for (uint8_t i = 0; i < ctx->address_count; i++) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_oui_v1_addresses_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)&ctx->addresses[i][1], SIZEOF_HELIUM_KEY);
+    }
+
+    if(ctx->filter_len) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_oui_v1_filter_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)ctx->filter, ctx->filter_len);
+    }
+
+    if(ctx->requested_subnet_size) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_oui_v1_requested_subnet_size_tag);
+        txn_encode_varint(ostream, ctx->requested_subnet_size);
+    }
+
+    if(has_payer(ctx)) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_oui_v1_payer_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)&ctx->payer[1], SIZEOF_HELIUM_KEY);
+    }
+
+    if(ctx->staking_fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_oui_v1_staking_fee_tag);
+        txn_encode_varint(ostream, ctx->staking_fee);
+    }
+
+    if(ctx->fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_oui_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
+    }
+
+    if(owner_signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_oui_v1_owner_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)owner_signature, SIZEOF_SIGNATURE);
+    }
+
+    if(payer_signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_oui_v1_payer_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)payer_signature, SIZEOF_SIGNATURE);
+    }
+
+    if(ctx->oui) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_oui_v1_oui_tag);
+        txn_encode_varint(ostream, ctx->oui);
+    }
+}
+
+// the fee is paid for a transaction carrying the signature of the payer,
+// when there is one, besides the owner's
+uint32_t size_helium_oui_txn(void){
+    unsigned char owner[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_oui_txn(&ostream, owner, signature, has_payer(&global.ouiContext) ? signature : NULL);
+    return ostream.bytes_written;
+}
+
+static bool stream_write(__attribute__((unused)) pb_ostream_t *stream, const pb_byte_t *buf, size_t count) {
+    sign_stream_update(SIGN_STREAM_OUI, buf, count);
+    return true;
+}
+
+static bool response_write(__attribute__((unused)) pb_ostream_t *stream, const pb_byte_t *buf, size_t count) {
+    return response_append(buf, count);
+}
+
+// With its addresses and filter, the unsigned transaction does not fit in
+// G_io_apdu_buffer, so it is signed as it is encoded.
+static void sign_oui_txn(unsigned char *signature, const accountPath_t *path, const unsigned char *owner){
+    pb_ostream_t ostream = {.callback = stream_write, .max_size = SIZE_MAX};
+    sign_stream_start(SIGN_STREAM_OUI, path, &global.ouiContext, sizeof(global.ouiContext));
+    encode_oui_txn(&ostream, owner, NULL, NULL);
+    sign_stream_finish(SIGN_STREAM_OUI, signature, path);
+}
+
+// create_helium_oui_txn appends the signed transaction to the outbound queue
+// (see response.h) and returns 0, as it does not fit in one APDU. The payer
+// signature is only there when both keys are on the device.
+uint32_t create_helium_oui_txn(const accountPath_t *path){
+    ouiContext_t * ctx = &global.ouiContext;
+    pb_ostream_t ostream = {.callback = response_write, .max_size = RESPONSE_CAPACITY};
+
+    unsigned char owner[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+    get_pubkey_bytes(path, &owner[1]);
+
+    unsigned char signature[SIZEOF_SIGNATURE];
+    sign_oui_txn(signature, path, owner);
+
+    if (ctx->both_signers) {
+        // the handler checked that the payer key is the one of payer_path
+        unsigned char payer_signature[SIZEOF_SIGNATURE];
+        sign_oui_txn(payer_signature, &ctx->payer_path, owner);
+        encode_oui_txn(&ostream, owner, signature, payer_signature);
+        return 0;
+    }
+
+    encode_oui_txn(&ostream, owner, signature, NULL);
+    return 0;
+}
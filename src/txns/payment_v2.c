@@ -1,87 +1,93 @@
 #include "helium.h"
 #include "pb.h"
 #include "pb_encode.h"
-#include "../proto/blockchain_txn.pb.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_payment_v2.pb.h"
 #include "save_context.h"
 
 // we only allow one payment
 // key + 2 x uint64 + some buffer
 #define MAX_PAYMENT_SIZE (SIZEOF_HELIUM_KEY+2*4+23)
 
-uint32_t create_helium_pay_txn(uint8_t account){
+// encode_pay_txn writes the transaction held in the context, including
+// 'signature' unless it is NULL.
+static void encode_pay_txn(pb_ostream_t *ostream, const unsigned char *payer, const unsigned char *signature){
     paymentContext_t * ctx = &global.paymentContext;
-    pb_ostream_t ostream;
-
-    unsigned char payer[SIZEOF_HELIUM_KEY];
-#ifdef HELIUM_TESTNET
-    payer[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
-#else
-    payer[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
-#endif
-    get_pubkey_bytes(account, &payer[1]);
-
-    unsigned char signature[SIZEOF_SIGNATURE];
-    memset(signature, 0, SIZEOF_SIGNATURE);
 
     unsigned char payment[MAX_PAYMENT_SIZE];
     memset(payment, 0, MAX_PAYMENT_SIZE);
     uint8_t len_payments;
 
     // first encode the submessage
-    ostream = pb_ostream_from_buffer(payment, sizeof(payment));
+    pb_ostream_t substream = txn_ostream_from_buffer(payment, sizeof(payment));
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_payment_payee_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->payee[1], SIZEOF_HELIUM_KEY);
+    txn_encode_tag(&substream, PB_WT_STRING, helium_payment_payee_tag);
+    txn_encode_string(&substream, (const pb_byte_t*)&ctx->payee[1], SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_payment_amount_tag);
-    pb_encode_varint(&ostream, ctx->amount);
+    if(ctx->amount) {
+        txn_encode_tag(&substream, PB_WT_VARINT, helium_payment_amount_tag);
+        txn_encode_varint(&substream, ctx->amount);
+    }
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_payment_memo_tag);
-    pb_encode_varint(&ostream, ctx->memo);
+    if(ctx->memo) {
+        txn_encode_tag(&substream, PB_WT_VARINT, helium_payment_memo_tag);
+        txn_encode_varint(&substream, ctx->memo);
+    }
 
-    len_payments = ostream.bytes_written;
+    len_payments = substream.bytes_written;
 
     // now do the top-level message
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_payer_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)payer, SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_payer_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)payer, SIZEOF_HELIUM_KEY);
-
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_payments_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)payment, len_payments);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_payments_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)payment, len_payments);
 
     if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_payment_v2_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_payment_v2_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
     }
 
     if(ctx->nonce) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_payment_v2_nonce_tag);
-        pb_encode_varint(&ostream, ctx->nonce);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_payment_v2_nonce_tag);
+        txn_encode_varint(ostream, ctx->nonce);
     }
 
-    sign_tx(signature, account, G_io_apdu_buffer, ostream.bytes_written);
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
+}
 
-    // redo the top level message only
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_payer_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)payer, SIZEOF_HELIUM_KEY);
+uint32_t size_helium_pay_txn(void){
+    unsigned char payer[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_pay_txn(&ostream, payer, signature);
+    return ostream.bytes_written;
+}
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_payments_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)payment, len_payments);
+uint32_t create_helium_pay_txn(const accountPath_t *path){
+    pb_ostream_t ostream;
 
-    if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_payment_v2_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
-    }
+    unsigned char payer[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    payer[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
+#else
+    payer[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
+#endif
+    get_pubkey_bytes(path, &payer[1]);
 
-    if(ctx->nonce) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_payment_v2_nonce_tag);
-        pb_encode_varint(&ostream, ctx->nonce);
-    }
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_pay_txn(&ostream, payer, NULL);
+
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_payment_v2_signature_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_pay_txn(&ostream, payer, signature);
 
     return ostream.bytes_written;
 }
@@ -0,0 +1,57 @@
+#include "helium.h"
+#include "pb.h"
+#include "pb_encode.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_price_oracle_v1.pb.h"
+#include "save_context.h"
+
+// encode_price_oracle_txn writes the report held in the context, including
+// 'signature' unless it is NULL.
+static void encode_price_oracle_txn(pb_ostream_t *ostream, const unsigned char *signature){
+    priceOracleContext_t * ctx = &global.priceOracleContext;
+
+    unsigned char public_key[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    public_key[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+    public_key[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+    memmove(&public_key[1], ctx->public_key, sizeof(ctx->public_key));
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_price_oracle_v1_public_key_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)public_key, SIZEOF_HELIUM_KEY);
+
+    if(ctx->price) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_price_oracle_v1_price_tag);
+        txn_encode_varint(ostream, ctx->price);
+    }
+
+    if(ctx->block_height) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_price_oracle_v1_block_height_tag);
+        txn_encode_varint(ostream, ctx->block_height);
+    }
+
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_price_oracle_v1_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
+}
+
+// create_helium_price_oracle_txn signs with the key of 'path', whose public
+// key the context already holds, so that only the signature derives a key.
+uint32_t create_helium_price_oracle_txn(const accountPath_t *path){
+    pb_ostream_t ostream;
+
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_price_oracle_txn(&ostream, NULL);
+
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_price_oracle_txn(&ostream, signature);
+
+    return ostream.bytes_written;
+}
@@ -0,0 +1,66 @@
+#include "helium.h"
+#include "pb.h"
+#include "pb_encode.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_redeem_htlc_v1.pb.h"
+#include "save_context.h"
+
+// encode_redeem_htlc_txn writes the transaction held in the context,
+// including 'signature' unless it is NULL.
+static void encode_redeem_htlc_txn(pb_ostream_t *ostream, const unsigned char *payee, const unsigned char *signature){
+    redeemHtlcContext_t * ctx = &global.redeemHtlcContext;
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_redeem_htlc_v1_payee_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)payee, SIZEOF_HELIUM_KEY);
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_redeem_htlc_v1_address_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
+
+    if(ctx->preimage_len) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_redeem_htlc_v1_preimage_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)ctx->preimage, ctx->preimage_len);
+    }
+
+    if(ctx->fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_redeem_htlc_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
+    }
+
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_redeem_htlc_v1_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
+}
+
+uint32_t size_helium_redeem_htlc_txn(void){
+    unsigned char payee[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_redeem_htlc_txn(&ostream, payee, signature);
+    return ostream.bytes_written;
+}
+
+uint32_t create_helium_redeem_htlc_txn(const accountPath_t *path){
+    pb_ostream_t ostream;
+
+    unsigned char payee[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    payee[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+    payee[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+    get_pubkey_bytes(path, &payee[1]);
+
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_redeem_htlc_txn(&ostream, payee, NULL);
+
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_redeem_htlc_txn(&ostream, payee, signature);
+
+    return ostream.bytes_written;
+}
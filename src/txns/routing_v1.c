@@ -0,0 +1,138 @@
+#include "helium.h"
+#include "pb.h"
+#include "pb_encode.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_routing_v1.pb.h"
+#include "save_context.h"
+
+// The unsigned transaction goes straight into the signature's running hash;
+// it is never held.
+static bool stream_write(__attribute__((unused)) pb_ostream_t *stream, const pb_byte_t *buf, size_t count) {
+    sign_stream_update(SIGN_STREAM_ROUTING, buf, count);
+    return true;
+}
+
+static void encode_routers(pb_ostream_t *ostream, const routingContext_t *ctx){
+    for (uint8_t i = 0; i < ctx->router_count; i++) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_update_routers_router_addresses_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)&ctx->routers[i][1], SIZEOF_HELIUM_KEY);
+    }
+}
+
+// encode_xor_head writes an update_xor submessage up to its filter.
+static void encode_xor_head(pb_ostream_t *ostream, const routingContext_t *ctx){
+    if(ctx->xor_index) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_update_xor_index_tag);
+        txn_encode_varint(ostream, ctx->xor_index);
+    }
+    txn_encode_tag(ostream, PB_WT_STRING, helium_update_xor_filter_tag);
+    txn_encode_varint(ostream, ctx->filter_length);
+}
+
+// encode_routing_head writes the transaction up to its filter, which
+// filter_length bytes complete, or up to the fee when the update has none.
+static void encode_routing_head(pb_ostream_t *ostream, const routingContext_t *ctx, const unsigned char *owner){
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+
+    if(ctx->oui) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_routing_v1_oui_tag);
+        txn_encode_varint(ostream, ctx->oui);
+    }
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_routing_v1_owner_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)owner, SIZEOF_HELIUM_KEY);
+
+    // the members of the update oneof are written even when they are 0
+    switch (ctx->update) {
+    case ROUTING_UPDATE_ROUTERS:
+        encode_routers(&sizing, ctx);
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_routing_v1_update_routers_tag);
+        txn_encode_varint(ostream, sizing.bytes_written);
+        encode_routers(ostream, ctx);
+        break;
+    case ROUTING_NEW_XOR:
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_routing_v1_new_xor_tag);
+        txn_encode_varint(ostream, ctx->filter_length);
+        break;
+    case ROUTING_UPDATE_XOR:
+        encode_xor_head(&sizing, ctx);
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_routing_v1_update_xor_tag);
+        txn_encode_varint(ostream, sizing.bytes_written + ctx->filter_length);
+        encode_xor_head(ostream, ctx);
+        break;
+    case ROUTING_REQUEST_SUBNET:
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_routing_v1_request_subnet_tag);
+        txn_encode_varint(ostream, ctx->subnet_size);
+        break;
+    }
+}
+
+// encode_routing_tail writes what follows the update, including 'signature'
+// unless it is NULL.
+static void encode_routing_tail(pb_ostream_t *ostream, const routingContext_t *ctx, const unsigned char *signature){
+    if(ctx->fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_routing_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
+    }
+
+    if(ctx->nonce) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_routing_v1_nonce_tag);
+        txn_encode_varint(ostream, ctx->nonce);
+    }
+
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_routing_v1_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
+
+    if(ctx->staking_fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_routing_v1_staking_fee_tag);
+        txn_encode_varint(ostream, ctx->staking_fee);
+    }
+}
+
+static bool has_filter(const routingContext_t *ctx){
+    return ctx->update == ROUTING_NEW_XOR || ctx->update == ROUTING_UPDATE_XOR;
+}
+
+uint32_t size_helium_routing_txn(const routingContext_t *ctx){
+    unsigned char owner[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_routing_head(&ostream, ctx, owner);
+    encode_routing_tail(&ostream, ctx, signature);
+    return ostream.bytes_written + (has_filter(ctx) ? ctx->filter_length : 0);
+}
+
+void start_helium_routing_txn(const routingContext_t *ctx){
+    pb_ostream_t ostream = {.callback = stream_write, .max_size = SIZE_MAX};
+
+    unsigned char owner[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+    get_pubkey_bytes(&ctx->path, &owner[1]);
+
+    sign_stream_start(SIGN_STREAM_ROUTING, &ctx->path, ctx, sizeof(*ctx));
+    encode_routing_head(&ostream, ctx, owner);
+    if (!has_filter(ctx)) {
+        encode_routing_tail(&ostream, ctx, NULL);
+    }
+}
+
+void stream_helium_routing_filter(routingContext_t *ctx, const uint8_t *filter, uint16_t length){
+    pb_ostream_t ostream = {.callback = stream_write, .max_size = SIZE_MAX};
+
+    sign_stream_update(SIGN_STREAM_ROUTING, filter, length);
+    ctx->filter_received += length;
+    if (ctx->filter_received == ctx->filter_length) {
+        encode_routing_tail(&ostream, ctx, NULL);
+    }
+}
+
+uint32_t create_helium_routing_txn(const routingContext_t *ctx){
+    sign_stream_finish(SIGN_STREAM_ROUTING, G_io_apdu_buffer, &ctx->path);
+    return SIZEOF_SIGNATURE;
+}
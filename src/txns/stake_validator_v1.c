@@ -1,60 +1,66 @@
 #include "helium.h"
 #include "pb.h"
 #include "pb_encode.h"
-#include "../proto/blockchain_txn.pb.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_stake_validator_v1.pb.h"
 #include "save_context.h"
 
-uint32_t create_helium_stake_txn(uint8_t account){
+// encode_stake_txn writes the transaction held in the context, including
+// 'signature' unless it is NULL.
+static void encode_stake_txn(pb_ostream_t *ostream, const unsigned char *owner, const unsigned char *signature){
     stakeValidatorContext_t * ctx = &global.stakeValidatorContext;
-    pb_ostream_t ostream;
-
-    unsigned char owner[SIZEOF_HELIUM_KEY];
-#ifdef HELIUM_TESTNET
-    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
-#else
-    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
-#endif
-    get_pubkey_bytes(account, &owner[1]);
-
-    unsigned char signature[SIZEOF_SIGNATURE];
-    memset(signature, 0, SIZEOF_SIGNATURE);
 
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_address_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_owner_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)owner, SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&owner, SIZEOF_HELIUM_KEY);
+    if(ctx->stake) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_stake_validator_v1_stake_tag);
+        txn_encode_varint(ostream, ctx->stake);
+    }
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_stake_validator_v1_stake_tag);
-    pb_encode_varint(&ostream, ctx->stake);
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_owner_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
 
     if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_stake_validator_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_stake_validator_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
     }
+}
 
-    sign_tx(signature, account, G_io_apdu_buffer, ostream.bytes_written);
+uint32_t size_helium_stake_txn(void){
+    unsigned char owner[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_stake_txn(&ostream, owner, signature);
+    return ostream.bytes_written;
+}
 
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+uint32_t create_helium_stake_txn(const accountPath_t *path){
+    pb_ostream_t ostream;
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
+    unsigned char owner[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
+#else
+    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
+#endif
+    get_pubkey_bytes(path, &owner[1]);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&owner, SIZEOF_HELIUM_KEY);
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_stake_validator_v1_stake_tag);
-    pb_encode_varint(&ostream, ctx->stake);
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_stake_txn(&ostream, owner, NULL);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_stake_validator_v1_owner_signature_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
 
-    if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_stake_validator_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
-    }
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_stake_txn(&ostream, owner, signature);
 
     return ostream.bytes_written;
 }
@@ -0,0 +1,82 @@
+#include "helium.h"
+#include "pb.h"
+#include "pb_encode.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_state_channel_open_v1.pb.h"
+#include "save_context.h"
+
+// encode_state_channel_open_txn writes the transaction held in the context,
+// including 'signature' unless it is NULL.
+static void encode_state_channel_open_txn(pb_ostream_t *ostream, const unsigned char *owner, const unsigned char *signature){
+    stateChannelOpenContext_t * ctx = &global.stateChannelOpenContext;
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_state_channel_open_v1_id_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)ctx->id, ctx->id_len);
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_state_channel_open_v1_owner_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)owner, SIZEOF_HELIUM_KEY);
+
+    // amount and expire_within are int64, which the handler keeps positive
+    if(ctx->amount) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_state_channel_open_v1_amount_tag);
+        txn_encode_varint(ostream, ctx->amount);
+    }
+
+    if(ctx->expire_within) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_state_channel_open_v1_expire_within_tag);
+        txn_encode_varint(ostream, ctx->expire_within);
+    }
+
+    if(ctx->oui) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_state_channel_open_v1_oui_tag);
+        txn_encode_varint(ostream, ctx->oui);
+    }
+
+    if(ctx->nonce) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_state_channel_open_v1_nonce_tag);
+        txn_encode_varint(ostream, ctx->nonce);
+    }
+
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_state_channel_open_v1_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
+
+    if(ctx->fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_state_channel_open_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
+    }
+}
+
+uint32_t size_helium_state_channel_open_txn(void){
+    unsigned char owner[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_state_channel_open_txn(&ostream, owner, signature);
+    return ostream.bytes_written;
+}
+
+uint32_t create_helium_state_channel_open_txn(const accountPath_t *path){
+    pb_ostream_t ostream;
+
+    unsigned char owner[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+    get_pubkey_bytes(path, &owner[1]);
+
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_state_channel_open_txn(&ostream, owner, NULL);
+
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
+
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_state_channel_open_txn(&ostream, owner, signature);
+
+    return ostream.bytes_written;
+}
@@ -1,70 +1,71 @@
 #include "helium.h"
 #include "pb.h"
 #include "pb_encode.h"
-#include "../proto/blockchain_txn.pb.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_security_exchange_v1.pb.h"
 #include "save_context.h"
 
-uint32_t create_helium_transfer_sec(uint8_t account){
+// encode_transfer_sec writes the transaction held in the context, including
+// 'signature' unless it is NULL.
+static void encode_transfer_sec(pb_ostream_t *ostream, const unsigned char *payer, const unsigned char *signature){
     transferSecContext_t * ctx = &global.transferSecContext;
-    pb_ostream_t ostream;
 
-    unsigned char payer[SIZEOF_HELIUM_KEY];
-#ifdef HELIUM_TESTNET
-    payer[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
-#else
-    payer[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
-#endif
-    get_pubkey_bytes(account, &payer[1]);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_payer_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)payer, SIZEOF_HELIUM_KEY);
 
-    unsigned char signature[SIZEOF_SIGNATURE];
-    memset(signature, 0, SIZEOF_SIGNATURE);
-
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
-
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_payer_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)payer, SIZEOF_HELIUM_KEY);
-
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_payee_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->payee[1], SIZEOF_HELIUM_KEY);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_payee_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->payee[1], SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_amount_tag);
-    pb_encode_varint(&ostream, ctx->amount);
+    if(ctx->amount) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_amount_tag);
+        txn_encode_varint(ostream, ctx->amount);
+    }
 
     if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
     }
 
     if(ctx->nonce) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_nonce_tag);
-        pb_encode_varint(&ostream, ctx->nonce);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_nonce_tag);
+        txn_encode_varint(ostream, ctx->nonce);
     }
 
-    sign_tx(signature, account, G_io_apdu_buffer, ostream.bytes_written);
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
+}
 
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+uint32_t size_helium_transfer_sec(void){
+    unsigned char payer[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_transfer_sec(&ostream, payer, signature);
+    return ostream.bytes_written;
+}
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_payer_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)payer, SIZEOF_HELIUM_KEY);
+uint32_t create_helium_transfer_sec(const accountPath_t *path){
+    pb_ostream_t ostream;
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_payee_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->payee[1], SIZEOF_HELIUM_KEY);
+    unsigned char payer[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    payer[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
+#else
+    payer[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
+#endif
+    get_pubkey_bytes(path, &payer[1]);
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_amount_tag);
-    pb_encode_varint(&ostream, ctx->amount);
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
 
-    if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
-    }
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_transfer_sec(&ostream, payer, NULL);
 
-    if(ctx->nonce) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_security_exchange_v1_nonce_tag);
-        pb_encode_varint(&ostream, ctx->nonce);
-    }
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_security_exchange_v1_signature_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_transfer_sec(&ostream, payer, signature);
 
     return ostream.bytes_written;
 }
@@ -1,98 +1,110 @@
 #include "helium.h"
 #include "pb.h"
 #include "pb_encode.h"
-#include "../proto/blockchain_txn.pb.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_transfer_validator_stake_v1.pb.h"
 #include "save_context.h"
+#include "response.h"
 
-uint32_t create_helium_transfer_validator_txn(uint8_t account){
+// encode_transfer_validator_txn writes the transaction held in the context,
+// including each owner signature that is not NULL.
+static void encode_transfer_validator_txn(pb_ostream_t *ostream, const unsigned char *old_owner_signature, const unsigned char *new_owner_signature){
     transferValidatorContext_t * ctx = &global.transferValidatorContext;
-    pb_ostream_t ostream;
-
-    unsigned char owner[SIZEOF_HELIUM_KEY];
-#ifdef HELIUM_TESTNET
-    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
-#else
-    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
-#endif
-    get_pubkey_bytes(account, &owner[1]);
 
-    bool is_new_owner = (memcmp(owner, &ctx->new_owner[1], SIZEOF_HELIUM_KEY) == 0);
-    bool is_old_owner = (memcmp(owner, &ctx->old_owner[1], SIZEOF_HELIUM_KEY) == 0);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_address_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->old_address[1], SIZEOF_HELIUM_KEY);
 
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_address_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->new_address[1], SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->old_address[1], SIZEOF_HELIUM_KEY);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_owner_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->old_owner[1], SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->new_address[1], SIZEOF_HELIUM_KEY);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_owner_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->new_owner[1], SIZEOF_HELIUM_KEY);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->old_owner[1], SIZEOF_HELIUM_KEY);
+    if(old_owner_signature){
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_owner_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)old_owner_signature, SIZEOF_SIGNATURE);
+    }
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->new_owner[1], SIZEOF_HELIUM_KEY);
+    if(new_owner_signature){
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_owner_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)new_owner_signature, SIZEOF_SIGNATURE);
+    }
 
     if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
     }
 
     if(ctx->stake_amount) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_stake_amount_tag);
-        pb_encode_varint(&ostream, ctx->stake_amount);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_stake_amount_tag);
+        txn_encode_varint(ostream, ctx->stake_amount);
     }
 
     if(ctx->payment_amount) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_payment_amount_tag);
-        pb_encode_varint(&ostream, ctx->payment_amount);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_payment_amount_tag);
+        txn_encode_varint(ostream, ctx->payment_amount);
     }
+}
 
-    unsigned char signature[SIZEOF_SIGNATURE];
-    memset(signature, 0, SIZEOF_SIGNATURE);
-    sign_tx(signature, account, G_io_apdu_buffer, ostream.bytes_written);
+// the fee is paid for a transaction carrying both signatures
+uint32_t size_helium_transfer_validator_txn(void){
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_transfer_validator_txn(&ostream, signature, signature);
+    return ostream.bytes_written;
+}
 
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+static bool response_write(__attribute__((unused)) pb_ostream_t *stream, const pb_byte_t *buf, size_t count) {
+    return response_append(buf, count);
+}
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->old_address[1], SIZEOF_HELIUM_KEY);
+// create_helium_transfer_validator_txn appends the signed transaction to the
+// outbound queue (see response.h) and returns 0: with both signatures, it
+// does not fit in one APDU.
+uint32_t create_helium_transfer_validator_txn(const accountPath_t *path){
+    transferValidatorContext_t * ctx = &global.transferValidatorContext;
+    pb_ostream_t ostream;
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->new_address[1], SIZEOF_HELIUM_KEY);
+    unsigned char owner[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
+#else
+    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
+#endif
+    get_pubkey_bytes(path, &owner[1]);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->old_owner[1], SIZEOF_HELIUM_KEY);
+    bool is_new_owner = (memcmp(owner, &ctx->new_owner[1], SIZEOF_HELIUM_KEY) == 0);
+    bool is_old_owner = (memcmp(owner, &ctx->old_owner[1], SIZEOF_HELIUM_KEY) == 0);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->new_owner[1], SIZEOF_HELIUM_KEY);
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_transfer_validator_txn(&ostream, NULL, NULL);
+    uint16_t unsigned_length = ostream.bytes_written;
+
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
+    sign_tx(signature, path, G_io_apdu_buffer, unsigned_length);
+
+    ostream = (pb_ostream_t){.callback = response_write, .max_size = RESPONSE_CAPACITY};
+
+    if (ctx->both_owners) {
+        // the owners sign the same bytes, so the new owner's signature is
+        // made from the encoding above (the handler checked both keys)
+        unsigned char new_owner_signature[SIZEOF_SIGNATURE];
+        memset(new_owner_signature, 0, SIZEOF_SIGNATURE);
+        sign_tx(new_owner_signature, &ctx->new_owner_path, G_io_apdu_buffer, unsigned_length);
+        encode_transfer_validator_txn(&ostream, signature, new_owner_signature);
+        return 0;
+    }
 
     // to avoid two APDU transactions, we only write the signature once
     // the companion app must make the copy
     // ie: companion app must check if is_old_owner && is_new_owner; if so, copy signature
-    if(is_old_owner){
-        pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_old_owner_signature_tag);
-        pb_encode_string(&ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
-    }
-
-    if(is_new_owner && !is_old_owner){
-        pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_transfer_validator_stake_v1_new_owner_signature_tag);
-        pb_encode_string(&ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
-    }
-
-    if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
-    }
+    encode_transfer_validator_txn(&ostream,
+                                  is_old_owner ? signature : NULL,
+                                  is_new_owner && !is_old_owner ? signature : NULL);
 
-    if(ctx->stake_amount) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_stake_amount_tag);
-        pb_encode_varint(&ostream, ctx->stake_amount);
-    }
-
-    if(ctx->payment_amount) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_transfer_validator_stake_v1_payment_amount_tag);
-        pb_encode_varint(&ostream, ctx->payment_amount);
-    }
-
-    return ostream.bytes_written;
+    return 0;
 }
@@ -0,0 +1,15 @@
+#include "txn_encode.h"
+
+#ifndef TXN_ENCODE_GENERIC
+
+// txn_buffer_write is what nanopb's buffer streams do; txn_write only calls
+// it through pb_write when a buffer is about to overflow, for pb_write to
+// fail.
+bool txn_buffer_write(pb_ostream_t *stream, const pb_byte_t *buf, size_t count) {
+    pb_byte_t *dest = stream->state;
+    memmove(dest, buf, count);
+    stream->state = dest + count;
+    return true;
+}
+
+#endif
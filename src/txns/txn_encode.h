@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "pb.h"
+#include "pb_encode.h"
+
+// The builders in src/txns encode their transactions field by field. Their
+// schemas are fixed, so the txn_encode_* emitters below replace nanopb's
+// generic pb_encode_tag, pb_encode_varint and pb_encode_string with inline
+// versions:
+//
+// - every field number is below 16, so a key is one constant byte;
+// - varints are written whole, rather than a byte at a time;
+// - streams made by txn_ostream_from_buffer are written to directly, and
+//   sizing streams only count, without going through pb_write.
+//
+// Other streams, such as those of a signature's running hash, go through
+// pb_write as before, so the emitters take any stream. Build with
+// TXN_ENCODE_GENERIC to use nanopb's functions instead, for comparison.
+
+#ifdef TXN_ENCODE_GENERIC
+
+#define txn_ostream_from_buffer pb_ostream_from_buffer
+#define txn_encode_tag pb_encode_tag
+#define txn_encode_varint pb_encode_varint
+#define txn_encode_string pb_encode_string
+
+#else
+
+// TXN_KEY is the key of field 'field' with wire type 'wiretype'; it does not
+// compile for fields numbered 16 and above, whose keys take two bytes.
+#define TXN_KEY(wiretype, field) \
+    ((pb_byte_t)((((field) << 3) | (wiretype)) + 0 * sizeof(char[(field) < 16 ? 1 : -1])))
+
+#define txn_encode_tag(stream, wiretype, field) txn_encode_key((stream), TXN_KEY((wiretype), (field)))
+
+// txn_buffer_write is the callback of the streams made by
+// txn_ostream_from_buffer, which is how the emitters recognize them.
+bool txn_buffer_write(pb_ostream_t *stream, const pb_byte_t *buf, size_t count);
+
+static inline pb_ostream_t txn_ostream_from_buffer(pb_byte_t *buf, size_t bufsize) {
+    pb_ostream_t stream = {.callback = txn_buffer_write, .state = buf, .max_size = bufsize};
+    return stream;
+}
+
+static inline bool txn_write(pb_ostream_t *stream, const pb_byte_t *buf, size_t count) {
+    if (stream->callback == NULL) {
+        stream->bytes_written += count;
+        return true;
+    }
+    if (stream->callback == txn_buffer_write && count <= stream->max_size - stream->bytes_written) {
+        pb_byte_t *dest = stream->state;
+        memmove(dest, buf, count);
+        stream->state = dest + count;
+        stream->bytes_written += count;
+        return true;
+    }
+    return pb_write(stream, buf, count);
+}
+
+static inline bool txn_encode_key(pb_ostream_t *stream, pb_byte_t key) {
+    return txn_write(stream, &key, 1);
+}
+
+static inline bool txn_encode_varint(pb_ostream_t *stream, uint64_t value) {
+    pb_byte_t bytes[10];
+    size_t len = 0;
+    while (value > 0x7F) {
+        bytes[len++] = (pb_byte_t)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[len++] = (pb_byte_t)value;
+    return txn_write(stream, bytes, len);
+}
+
+static inline bool txn_encode_string(pb_ostream_t *stream, const pb_byte_t *buf, size_t size) {
+    return txn_encode_varint(stream, size) && txn_write(stream, buf, size);
+}
+
+#endif
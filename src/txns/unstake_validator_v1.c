@@ -1,78 +1,71 @@
 #include "helium.h"
 #include "pb.h"
 #include "pb_encode.h"
-#include "../proto/blockchain_txn.pb.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_unstake_validator_v1.pb.h"
 #include "save_context.h"
 
-uint32_t create_helium_unstake_txn(uint8_t account){
+// encode_unstake_txn writes the transaction held in the context, including
+// 'signature' unless it is NULL.
+static void encode_unstake_txn(pb_ostream_t *ostream, const unsigned char *owner, const unsigned char *signature){
     unstakeValidatorContext_t * ctx = &global.unstakeValidatorContext;
-    pb_ostream_t ostream;
 
-    unsigned char owner[SIZEOF_HELIUM_KEY];
-#ifdef HELIUM_TESTNET
-    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
-#else
-    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
-#endif
-    get_pubkey_bytes(account, &owner[1]);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_address_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
 
-    unsigned char signature[SIZEOF_SIGNATURE];
-    memset(signature, 0, SIZEOF_SIGNATURE);
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_owner_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)owner, SIZEOF_HELIUM_KEY);
 
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
-
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
-
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&owner, SIZEOF_HELIUM_KEY);
+    if(signature) {
+        txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_owner_signature_tag);
+        txn_encode_string(ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+    }
 
     if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
     }
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_stake_amount_tag);
-    pb_encode_varint(&ostream, ctx->stake_amount);
-
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_stake_release_height_tag);
-    pb_encode_varint(&ostream, ctx->stake_release_height);
-
-    sign_tx(signature, account, G_io_apdu_buffer, ostream.bytes_written);
-
-    ostream = pb_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
-
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
+    if(ctx->stake_amount) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_stake_amount_tag);
+        txn_encode_varint(ostream, ctx->stake_amount);
+    }
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&owner, SIZEOF_HELIUM_KEY);
+    if(ctx->stake_release_height) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_stake_release_height_tag);
+        txn_encode_varint(ostream, ctx->stake_release_height);
+    }
+}
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_owner_signature_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)signature, SIZEOF_SIGNATURE);
+uint32_t size_helium_unstake_txn(void){
+    unsigned char owner[SIZEOF_HELIUM_KEY] = {0};
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_unstake_txn(&ostream, owner, signature);
+    return ostream.bytes_written;
+}
 
-    if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
-    }
+uint32_t create_helium_unstake_txn(const accountPath_t *path){
+    pb_ostream_t ostream;
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_stake_amount_tag);
-    pb_encode_varint(&ostream, ctx->stake_amount);    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_address_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&ctx->address[1], SIZEOF_HELIUM_KEY);
+    unsigned char owner[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+    owner[0] = NETTYPE_TEST | KEYTYPE_ED25519;;
+#else
+    owner[0] = NETTYPE_MAIN | KEYTYPE_ED25519;;
+#endif
+    get_pubkey_bytes(path, &owner[1]);
 
-    pb_encode_tag(&ostream, PB_WT_STRING, helium_blockchain_txn_unstake_validator_v1_owner_tag);
-    pb_encode_string(&ostream, (const pb_byte_t*)&owner, SIZEOF_HELIUM_KEY);
+    unsigned char signature[SIZEOF_SIGNATURE];
+    memset(signature, 0, SIZEOF_SIGNATURE);
 
-    if(ctx->fee) {
-        pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_fee_tag);
-        pb_encode_varint(&ostream, ctx->fee);
-    }
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_unstake_txn(&ostream, owner, NULL);
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_stake_amount_tag);
-    pb_encode_varint(&ostream, ctx->stake_amount);
+    sign_tx(signature, path, G_io_apdu_buffer, ostream.bytes_written);
 
-    pb_encode_tag(&ostream, PB_WT_VARINT, helium_blockchain_txn_unstake_validator_v1_stake_release_height_tag);
-    pb_encode_varint(&ostream, ctx->stake_release_height);
+    ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    encode_unstake_txn(&ostream, owner, signature);
 
     return ostream.bytes_written;
 }
@@ -0,0 +1,64 @@
+#include "helium.h"
+#include "pb.h"
+#include "pb_encode.h"
+#include "txn_encode.h"
+#include "../proto/blockchain_txn_update_gateway_oui_v1.pb.h"
+#include "save_context.h"
+
+// encode_update_gateway_oui_txn writes the transaction held in the context
+// up to its signatures, which are its last fields.
+static void encode_update_gateway_oui_txn(pb_ostream_t *ostream){
+    updateGatewayOuiContext_t * ctx = &global.updateGatewayOuiContext;
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_update_gateway_oui_v1_gateway_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)&ctx->gateway[1], SIZEOF_HELIUM_KEY);
+
+    if(ctx->oui) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_update_gateway_oui_v1_oui_tag);
+        txn_encode_varint(ostream, ctx->oui);
+    }
+
+    if(ctx->nonce) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_update_gateway_oui_v1_nonce_tag);
+        txn_encode_varint(ostream, ctx->nonce);
+    }
+
+    if(ctx->fee) {
+        txn_encode_tag(ostream, PB_WT_VARINT, helium_blockchain_txn_update_gateway_oui_v1_fee_tag);
+        txn_encode_varint(ostream, ctx->fee);
+    }
+}
+
+static void encode_signatures(pb_ostream_t *ostream, const unsigned char *gateway_owner_signature, const unsigned char *oui_owner_signature){
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_update_gateway_oui_v1_gateway_owner_signature_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)gateway_owner_signature, SIZEOF_SIGNATURE);
+
+    txn_encode_tag(ostream, PB_WT_STRING, helium_blockchain_txn_update_gateway_oui_v1_oui_owner_signature_tag);
+    txn_encode_string(ostream, (const pb_byte_t*)oui_owner_signature, SIZEOF_SIGNATURE);
+}
+
+uint32_t size_helium_update_gateway_oui_txn(void){
+    unsigned char signature[SIZEOF_SIGNATURE] = {0};
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+    encode_update_gateway_oui_txn(&ostream);
+    encode_signatures(&ostream, signature, signature);
+    return ostream.bytes_written;
+}
+
+// create_helium_update_gateway_oui_txn encodes the transaction once: both
+// owners sign the same unsigned bytes, and as the signatures come last
+// they are appended to them in place.
+uint32_t create_helium_update_gateway_oui_txn(const accountPath_t *path){
+    updateGatewayOuiContext_t * ctx = &global.updateGatewayOuiContext;
+    pb_ostream_t ostream = txn_ostream_from_buffer(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+
+    encode_update_gateway_oui_txn(&ostream);
+
+    unsigned char gateway_owner_signature[SIZEOF_SIGNATURE];
+    unsigned char oui_owner_signature[SIZEOF_SIGNATURE];
+    sign_tx(gateway_owner_signature, path, G_io_apdu_buffer, ostream.bytes_written);
+    sign_tx(oui_owner_signature, &ctx->oui_owner_path, G_io_apdu_buffer, ostream.bytes_written);
+
+    encode_signatures(&ostream, gateway_owner_signature, oui_owner_signature);
+    return ostream.bytes_written;
+}
@@ -0,0 +1,94 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "address_book.h"
+#include "save_context.h"
+
+#define CTX global.addressBookContext
+
+// The address book is kept in NVM, so it survives power cycles and app
+// updates that keep the data. It starts out empty.
+const addressBook_t N_address_book_real;
+#define N_address_book ((addressBook_t *)PIC(&N_address_book_real))
+
+static void address_book_nvm_write(void *dst, const void *src, size_t len) {
+	nvm_write(dst, (void *)src, len);
+}
+
+const char *address_book_label(const unsigned char *key) {
+	int i = address_book_find(N_address_book, key);
+	if (i < 0) {
+		return NULL;
+	}
+	return N_address_book->entries[i].label;
+}
+
+// address_book_commit applies the approved change and responds with a 1 byte
+// followed by the new number of entries.
+static uint32_t address_book_commit(__attribute__((unused)) const accountPath_t *path) {
+	if (CTX.operation == P1_ADDRESS_BOOK_ADD) {
+		address_book_add(N_address_book, &CTX.entry, address_book_nvm_write);
+	} else {
+		address_book_remove(N_address_book, CTX.entry.key, address_book_nvm_write);
+	}
+	G_io_apdu_buffer[0] = 1;
+	G_io_apdu_buffer[1] = N_address_book->count;
+	return 2;
+}
+
+static const review_field_t address_book_add_fields[] = {
+	{"Trust Address", review_format_address, global.addressBookContext.entry.key, NULL},
+	{"Label", review_format_text, global.addressBookContext.entry.label, NULL},
+};
+
+static const review_field_t address_book_remove_fields[] = {
+	{"Untrust Address", review_format_address, global.addressBookContext.entry.key, NULL},
+	{"Label", review_format_text, global.addressBookContext.entry.label, NULL},
+};
+
+// handle_address_book adds (P1 = 0x00) or removes (P1 = 0x01) a trusted
+// recipient. The payload is the 34-byte key, followed for additions by a label
+// of up to 15 characters. Either change must be confirmed on the device.
+void handle_address_book(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                         __attribute__((unused)) volatile unsigned int *tx) {
+	if (dataLength < SIZEOF_B58_KEY) {
+		THROW(SW_INVALID_PARAM);
+	}
+	save_address_book_context(p1, p2, dataBuffer, dataLength, &CTX);
+
+	int i = address_book_find(N_address_book, CTX.entry.key);
+	switch (p1) {
+	case P1_ADDRESS_BOOK_ADD:
+		if (dataLength == SIZEOF_B58_KEY || dataLength > SIZEOF_B58_KEY + ADDRESS_BOOK_LABEL_LEN - 1) {
+			THROW(SW_INVALID_PARAM);
+		}
+		// labels are shown on screen as is, so only accept printable ASCII
+		for (uint16_t j = SIZEOF_B58_KEY; j < dataLength; j++) {
+			if (dataBuffer[j] < 0x20 || dataBuffer[j] > 0x7E) {
+				THROW(SW_INVALID_PARAM);
+			}
+		}
+		if (i < 0 && N_address_book->count >= ADDRESS_BOOK_CAPACITY) {
+			THROW(SW_ADDRESS_BOOK_FULL);
+		}
+		ui_review_start(address_book_add_fields, REVIEW_FIELD_COUNT(address_book_add_fields), "Trust address?", address_book_commit, NULL);
+		break;
+
+	case P1_ADDRESS_BOOK_REMOVE:
+		if (i < 0) {
+			THROW(SW_INVALID_PARAM);
+		}
+		memmove(CTX.entry.label, N_address_book->entries[i].label, sizeof(CTX.entry.label));
+		ui_review_start(address_book_remove_fields, REVIEW_FIELD_COUNT(address_book_remove_fields), "Untrust address?", address_book_commit, NULL);
+		break;
+
+	default:
+		THROW(SW_INVALID_PARAM);
+	}
+	*flags |= IO_ASYNCH_REPLY;
+}
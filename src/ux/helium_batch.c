@@ -0,0 +1,422 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include <cx.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "save_context.h"
+#include "response.h"
+#include "fee.h"
+
+// A batch signs a run of payment_v2, token_burn_v1, state_channel_open_v1
+// or create_htlc_v1 transactions from one account with consecutive nonces,
+// a run of update_gateway_oui_v1 transactions moving gateways to one OUI, or
+// a run of redeem_htlc_v1 transactions, such as the settlement window of an
+// OTC desk, after a single review of the whole run:
+//
+//   P1_BATCH_START    the run: type, first nonce, count, total, fee and the
+//                     digest of its entries, and for state channels the
+//                     blocks they expire within, or for gateway moves the
+//                     OUI and both owners' paths. The user approves it on
+//                     the device.
+//   P1_BATCH_ENTRIES  up to BATCH_ENTRIES_PER_APDU (amount, memo, payee)
+//                     entries, (OUI, amount, id) ones for state channels,
+//                     (gateway, nonce) ones for gateway moves, (amount,
+//                     timelock, payee, address, hashlock) ones for HTLCs
+//                     or (address, hashlock, preimage) ones for redeems,
+//                     whose preimages are checked against the hashlocks
+//                     sent with them. Each is followed by the
+//                     digest of the entries after it (see save_context.h),
+//                     and checked against the chain of digests before any
+//                     is signed. Each is signed with the next nonce, or its
+//                     own for gateways, and sent back as a length byte
+//                     followed by the transaction.
+//   P1_BATCH_FINISH   ends the run. The reply is the number of transactions
+//                     signed (2 bytes, little-endian) and the running hash.
+//
+// The review shows the digest of the entries, in Base64, for the user to
+// compare with the one the source of the run shows, such as the settlement
+// file it was exported to: every entry signed is one the digest commits to,
+// in order, whatever the host sends.
+//
+// The running hash is the SHA-256 of, for every transaction signed in
+// order, its nonce (8 bytes, little-endian; for redeems, which have none,
+// its index in the run), its length (2 bytes,
+// little-endian) and its bytes. The host can recompute it from what it
+// received to show that the run has no gaps or duplicates.
+
+static batchContext_t batch;
+static bool batch_approved;
+static uint64_t batch_signed;
+static uint64_t batch_spent;
+static cx_sha256_t batch_hash;
+// the digest the next entry must have
+static uint8_t batch_link[BATCH_DIGEST_LEN];
+static const uint8_t no_digest[BATCH_DIGEST_LEN] = {0};
+
+void batch_reset(void) {
+	memset(&batch, 0, sizeof(batch));
+	memset(batch_link, 0, sizeof(batch_link));
+	batch_approved = false;
+	batch_signed = 0;
+	batch_spent = 0;
+}
+
+static uint32_t batch_approve(__attribute__((unused)) const accountPath_t *path) {
+	batch_approved = true;
+	memmove(batch_link, batch.entries_digest, sizeof(batch_link));
+	cx_sha256_init(&batch_hash);
+	G_io_apdu_buffer[0] = 1;
+	return 1;
+}
+
+static uint8_t format_digest(uint8_t *dst, const void *value) {
+	return bytes_to_base64(dst, value, BATCH_DIGEST_LEN);
+}
+
+// Without a fee in the request, each transaction of the run pays the fee of
+// its own size (see fee.h).
+static uint8_t format_fee(uint8_t *dst, const void *value) {
+	if (*(const uint64_t *)value == 0 && fee_params_set()) {
+		return review_format_text(dst, "By size");
+	}
+	return review_format_u64(dst, value);
+}
+
+static const review_field_t batch_payment_fields[] = {
+	{"Number of Payments", review_format_u64, &batch.count, NULL},
+	{"Total " TICKER_HNT, review_format_hnt, &batch.total, NULL},
+	{"Entries SHA-256", format_digest, batch.entries_digest, NULL},
+	{"First Nonce", review_format_u64, &batch.first_nonce, NULL},
+	{"Last Nonce", review_format_u64, &batch.last_nonce, NULL},
+	{"Data Credit Fee", format_fee, &batch.fee, NULL},
+};
+
+static const review_field_t batch_burn_fields[] = {
+	{"Number of Burns", review_format_u64, &batch.count, NULL},
+	{"Total " TICKER_HNT, review_format_hnt, &batch.total, NULL},
+	{"Entries SHA-256", format_digest, batch.entries_digest, NULL},
+	{"First Nonce", review_format_u64, &batch.first_nonce, NULL},
+	{"Last Nonce", review_format_u64, &batch.last_nonce, NULL},
+	{"Data Credit Fee", format_fee, &batch.fee, NULL},
+};
+
+// The channels of a run can be opened for any OUIs, with any amounts, which
+// the review cannot list: it shows the digest that binds them, and what the
+// run commits the account to.
+static const review_field_t batch_channel_fields[] = {
+	{"Number of Channels", review_format_u64, &batch.count, NULL},
+	{"Total DC", review_format_u64, &batch.total, NULL},
+	{"Entries SHA-256", format_digest, batch.entries_digest, NULL},
+	{"Expires Within", review_format_u64, &batch.expire_within, NULL},
+	{"First Nonce", review_format_u64, &batch.first_nonce, NULL},
+	{"Last Nonce", review_format_u64, &batch.last_nonce, NULL},
+	{"Data Credit Fee", format_fee, &batch.fee, NULL},
+};
+
+// Gateway moves are signed by the owners of the gateways and of the OUI,
+// and cost no HNT. The gateways are bound by the digest of the entries.
+static const review_field_t batch_gateway_fields[] = {
+	{"Number of Gateways", review_format_u64, &batch.count, NULL},
+	{"New OUI", review_format_u64, &batch.oui, NULL},
+	{"Entries SHA-256", format_digest, batch.entries_digest, NULL},
+	{"Data Credit Fee", format_fee, &batch.fee, NULL},
+	{"Sign As", review_format_text, "Both Owners", NULL},
+};
+
+// The payees, hashlocks and timelocks of the HTLCs are bound by the digest
+// of the entries.
+static const review_field_t batch_create_htlc_fields[] = {
+	{"Number of HTLCs", review_format_u64, &batch.count, NULL},
+	{"Total " TICKER_HNT, review_format_hnt, &batch.total, NULL},
+	{"Entries SHA-256", format_digest, batch.entries_digest, NULL},
+	{"First Nonce", review_format_u64, &batch.first_nonce, NULL},
+	{"Last Nonce", review_format_u64, &batch.last_nonce, NULL},
+	{"Data Credit Fee", format_fee, &batch.fee, NULL},
+};
+
+// Redeems move HNT to the account, so the run is reviewed by its size, the
+// digest that binds the HTLCs it redeems, and its fee.
+static const review_field_t batch_redeem_htlc_fields[] = {
+	{"Number of Redeems", review_format_u64, &batch.count, NULL},
+	{"Entries SHA-256", format_digest, batch.entries_digest, NULL},
+	{"Data Credit Fee", format_fee, &batch.fee, NULL},
+};
+
+static void batch_start(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength) {
+	batch_reset();
+	if (!save_batch_context(p1, p2, dataBuffer, dataLength, &batch)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	if (batch.count == 0) {
+		THROW(SW_INVALID_PARAM);
+	}
+	if (batch.type == BATCH_TYPE_UPDATE_GATEWAY_OUI || batch.type == BATCH_TYPE_REDEEM_HTLC) {
+		// each gateway has its own nonce, and redeems have none
+		if (batch.first_nonce != 0 || batch.total != 0) {
+			THROW(SW_INVALID_PARAM);
+		}
+	} else if (batch.first_nonce == 0 || batch.last_nonce < batch.first_nonce) {
+		THROW(SW_INVALID_PARAM);
+	}
+
+	switch (batch.type) {
+	case BATCH_TYPE_PAYMENT:
+		ui_review_start(batch_payment_fields, REVIEW_FIELD_COUNT(batch_payment_fields), "Sign all payments?", batch_approve, &batch.path);
+		break;
+	case BATCH_TYPE_BURN:
+		ui_review_start(batch_burn_fields, REVIEW_FIELD_COUNT(batch_burn_fields), "Sign all burns?", batch_approve, &batch.path);
+		break;
+	case BATCH_TYPE_STATE_CHANNEL_OPEN:
+		// amount and expire_within are int64 on the chain
+		if (batch.total > INT64_MAX || batch.expire_within == 0 || batch.expire_within > INT64_MAX) {
+			THROW(SW_INVALID_PARAM);
+		}
+		ui_review_start(batch_channel_fields, REVIEW_FIELD_COUNT(batch_channel_fields), "Open all channels?", batch_approve, &batch.path);
+		break;
+	case BATCH_TYPE_UPDATE_GATEWAY_OUI:
+		ui_review_start(batch_gateway_fields, REVIEW_FIELD_COUNT(batch_gateway_fields), "Move all gateways?", batch_approve, &batch.path);
+		break;
+	case BATCH_TYPE_CREATE_HTLC:
+		ui_review_start(batch_create_htlc_fields, REVIEW_FIELD_COUNT(batch_create_htlc_fields), "Create all HTLCs?", batch_approve, &batch.path);
+		break;
+	case BATCH_TYPE_REDEEM_HTLC:
+		ui_review_start(batch_redeem_htlc_fields, REVIEW_FIELD_COUNT(batch_redeem_htlc_fields), "Redeem all HTLCs?", batch_approve, &batch.path);
+		break;
+	default:
+		THROW(SW_INVALID_PARAM);
+	}
+}
+
+// batch_sign_entry builds and signs the next transaction of the run, leaving
+// it in G_io_apdu_buffer, and returns its length.
+static uint32_t batch_sign_entry(const batchEntry_t *entry, uint64_t nonce) {
+	switch (batch.type) {
+	case BATCH_TYPE_PAYMENT: {
+		paymentContext_t *ctx = &global.paymentContext;
+		ctx->path = batch.path;
+		ctx->amount = entry->amount;
+		ctx->memo = entry->memo;
+		ctx->nonce = nonce;
+		ctx->fee = batch.fee;
+		memmove(ctx->payee, entry->payee, sizeof(ctx->payee));
+		fee_fill(&ctx->fee, size_helium_pay_txn);
+		return create_helium_pay_txn(&batch.path);
+	}
+	case BATCH_TYPE_UPDATE_GATEWAY_OUI: {
+		updateGatewayOuiContext_t *ctx = &global.updateGatewayOuiContext;
+		ctx->path = batch.path;
+		ctx->oui_owner_path = batch.oui_owner_path;
+		ctx->oui = batch.oui;
+		ctx->nonce = nonce;
+		ctx->fee = batch.fee;
+		memmove(ctx->gateway, entry->payee, sizeof(ctx->gateway));
+		fee_fill(&ctx->fee, size_helium_update_gateway_oui_txn);
+		return create_helium_update_gateway_oui_txn(&batch.path);
+	}
+	case BATCH_TYPE_STATE_CHANNEL_OPEN: {
+		stateChannelOpenContext_t *ctx = &global.stateChannelOpenContext;
+		ctx->path = batch.path;
+		ctx->amount = entry->amount;
+		ctx->expire_within = batch.expire_within;
+		ctx->oui = entry->oui;
+		ctx->nonce = nonce;
+		ctx->fee = batch.fee;
+		ctx->id_len = entry->id_len;
+		memmove(ctx->id, entry->id, sizeof(ctx->id));
+		fee_fill(&ctx->fee, size_helium_state_channel_open_txn);
+		return create_helium_state_channel_open_txn(&batch.path);
+	}
+	case BATCH_TYPE_CREATE_HTLC: {
+		createHtlcContext_t *ctx = &global.createHtlcContext;
+		ctx->path = batch.path;
+		ctx->amount = entry->amount;
+		ctx->timelock = entry->timelock;
+		ctx->nonce = nonce;
+		ctx->fee = batch.fee;
+		memmove(ctx->payee, entry->payee, sizeof(ctx->payee));
+		memmove(ctx->address, entry->address, sizeof(ctx->address));
+		memmove(ctx->hashlock, entry->hashlock, sizeof(ctx->hashlock));
+		fee_fill(&ctx->fee, size_helium_create_htlc_txn);
+		return create_helium_create_htlc_txn(&batch.path);
+	}
+	case BATCH_TYPE_REDEEM_HTLC: {
+		redeemHtlcContext_t *ctx = &global.redeemHtlcContext;
+		ctx->path = batch.path;
+		ctx->fee = batch.fee;
+		memmove(ctx->address, entry->address, sizeof(ctx->address));
+		memmove(ctx->hashlock, entry->hashlock, sizeof(ctx->hashlock));
+		ctx->preimage_len = entry->preimage_len;
+		memmove(ctx->preimage, entry->preimage, sizeof(ctx->preimage));
+		fee_fill(&ctx->fee, size_helium_redeem_htlc_txn);
+		return create_helium_redeem_htlc_txn(&batch.path);
+	}
+	default: {
+		burnContext_t *ctx = &global.burnContext;
+		ctx->path = batch.path;
+		ctx->amount = entry->amount;
+		ctx->memo = entry->memo;
+		ctx->nonce = nonce;
+		ctx->fee = batch.fee;
+		memmove(ctx->payee, entry->payee, sizeof(ctx->payee));
+		fee_fill(&ctx->fee, size_helium_burn_txn);
+		return create_helium_burn_txn(&batch.path);
+	}
+	}
+}
+
+// batch_entry_size returns the size of an entry of the run, without the
+// digest that follows it.
+static uint16_t batch_entry_size(void) {
+	switch (batch.type) {
+	case BATCH_TYPE_STATE_CHANNEL_OPEN:
+		return SIZEOF_BATCH_CHANNEL_ENTRY;
+	case BATCH_TYPE_UPDATE_GATEWAY_OUI:
+		return SIZEOF_BATCH_GATEWAY_ENTRY;
+	case BATCH_TYPE_CREATE_HTLC:
+		return SIZEOF_BATCH_CREATE_HTLC_ENTRY;
+	case BATCH_TYPE_REDEEM_HTLC:
+		return SIZEOF_BATCH_REDEEM_HTLC_ENTRY;
+	default:
+		return SIZEOF_BATCH_ENTRY;
+	}
+}
+
+// batch_check_link checks the entry of 'entry_size' bytes at 'entry', which
+// the digest of the next one follows, against 'link', and moves 'link' on
+// to that digest.
+static void batch_check_link(const uint8_t *entry, uint16_t entry_size, uint8_t *link) {
+	cx_sha256_t hash;
+	uint8_t digest[BATCH_DIGEST_LEN];
+
+	cx_sha256_init(&hash);
+	cx_hash(&hash.header, CX_LAST, entry, entry_size + BATCH_DIGEST_LEN, digest, sizeof(digest));
+	if (memcmp(digest, link, sizeof(digest)) != 0) {
+		THROW(SW_INVALID_PARAM);
+	}
+	memmove(link, &entry[entry_size], BATCH_DIGEST_LEN);
+}
+
+static void batch_entries(uint8_t *dataBuffer, uint16_t dataLength) {
+	uint16_t entry_size = batch_entry_size();
+	uint16_t stride = entry_size + BATCH_DIGEST_LEN;
+	uint8_t count = dataLength / stride;
+	batchEntry_t *entries = global.batchEntriesContext.entries;
+	uint8_t link[BATCH_DIGEST_LEN];
+
+	if (!batch_approved) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	if (count == 0 || count > BATCH_ENTRIES_PER_APDU || dataLength != count * stride ||
+	    count > batch.count - batch_signed) {
+		THROW(SW_INVALID_PARAM);
+	}
+	// the entries must be saved before the first transaction overwrites
+	// G_io_apdu_buffer; they are all checked before any is signed
+	uint64_t spent = batch_spent;
+	memmove(link, batch_link, sizeof(link));
+	for (uint8_t i = 0; i < count; i++) {
+		batch_check_link(&dataBuffer[i * stride], entry_size, link);
+		switch (batch.type) {
+		case BATCH_TYPE_STATE_CHANNEL_OPEN:
+			save_batch_channel_entry(&dataBuffer[i * stride], &entries[i]);
+			if (entries[i].id_len == 0 || entries[i].id_len > STATE_CHANNEL_ID_MAX) {
+				THROW(SW_INVALID_PARAM);
+			}
+			break;
+		case BATCH_TYPE_UPDATE_GATEWAY_OUI:
+			save_batch_gateway_entry(&dataBuffer[i * stride], &entries[i]);
+			break;
+		case BATCH_TYPE_CREATE_HTLC:
+			save_batch_create_htlc_entry(&dataBuffer[i * stride], &entries[i]);
+			if (entries[i].amount == 0 || entries[i].timelock == 0) {
+				THROW(SW_INVALID_PARAM);
+			}
+			break;
+		case BATCH_TYPE_REDEEM_HTLC:
+			save_batch_redeem_htlc_entry(&dataBuffer[i * stride], &entries[i]);
+			if (entries[i].preimage_len == 0 || entries[i].preimage_len > HTLC_PREIMAGE_MAX ||
+			    !htlc_preimage_matches(entries[i].preimage, entries[i].preimage_len, entries[i].hashlock)) {
+				THROW(SW_INVALID_PARAM);
+			}
+			break;
+		default:
+			save_batch_entry(&dataBuffer[i * stride], &entries[i]);
+			break;
+		}
+		if (entries[i].amount > batch.total - spent) {
+			THROW(SW_INVALID_PARAM);
+		}
+		spent += entries[i].amount;
+	}
+	// the digest ends with the run
+	if (batch_signed + count == batch.count && memcmp(link, no_digest, sizeof(link)) != 0) {
+		THROW(SW_INVALID_PARAM);
+	}
+	memmove(batch_link, link, sizeof(batch_link));
+
+	for (uint8_t i = 0; i < count; i++) {
+		uint64_t nonce;
+		switch (batch.type) {
+		case BATCH_TYPE_UPDATE_GATEWAY_OUI:
+			nonce = entries[i].nonce;
+			break;
+		case BATCH_TYPE_REDEEM_HTLC:
+			nonce = batch_signed;
+			break;
+		default:
+			nonce = batch.first_nonce + batch_signed;
+			break;
+		}
+		uint8_t header[10];
+		uint8_t len = batch_sign_entry(&entries[i], nonce);
+
+		for (uint8_t j = 0; j < 8; j++) {
+			header[j] = nonce >> (8 * j);
+		}
+		header[8] = len;
+		header[9] = 0;
+		cx_hash(&batch_hash.header, 0, header, sizeof(header), NULL, 0);
+		cx_hash(&batch_hash.header, 0, G_io_apdu_buffer, len, NULL, 0);
+
+		response_append(&len, 1);
+		response_append(G_io_apdu_buffer, len);
+		batch_signed++;
+		batch_spent += entries[i].amount;
+	}
+	io_exchange_response();
+}
+
+static void batch_finish(void) {
+	if (!batch_approved) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	G_io_apdu_buffer[0] = batch_signed;
+	G_io_apdu_buffer[1] = batch_signed >> 8;
+	cx_hash(&batch_hash.header, CX_LAST, NULL, 0, &G_io_apdu_buffer[2], 32);
+	batch_reset();
+	io_exchange_with_code(SW_OK, 34);
+}
+
+// handle_sign_batch is the entry point for the signBatch command, which P1
+// steps through as described above.
+void handle_sign_batch(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                       __attribute__((unused)) volatile unsigned int *tx) {
+	switch (p1) {
+	case P1_BATCH_START:
+		batch_start(p1, p2, dataBuffer, dataLength);
+		*flags |= IO_ASYNCH_REPLY;
+		break;
+	case P1_BATCH_ENTRIES:
+		batch_entries(dataBuffer, dataLength);
+		break;
+	case P1_BATCH_FINISH:
+		batch_finish();
+		break;
+	default:
+		THROW(SW_INVALID_PARAM);
+	}
+}
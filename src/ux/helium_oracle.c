@@ -0,0 +1,153 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "oracle_policy.h"
+#include "save_context.h"
+
+#define CTX global.oraclePolicyContext
+
+// The oracle policy is kept in NVM, so that an oracle keeps reporting across
+// power cycles, and so that a restart never lets it sign an older height. It
+// starts out disabled.
+const oraclePolicy_t N_oracle_policy_real;
+#define N_oracle_policy ((oraclePolicy_t *)PIC(&N_oracle_policy_real))
+
+static void oracle_policy_nvm_write(void *dst, const void *src, size_t len) {
+	nvm_write(dst, (void *)src, len);
+}
+
+// oracle_policy_commit stores the approved policy and responds with a 1
+// byte.
+static uint32_t oracle_policy_commit(__attribute__((unused)) const accountPath_t *path) {
+	oraclePolicy_t policy;
+	memset(&policy, 0, sizeof(policy));
+	policy.path = CTX.path;
+	memmove(policy.public_key, &CTX.key[2], sizeof(policy.public_key));
+	policy.max_delta_bps = CTX.max_delta_bps;
+	policy.min_blocks = CTX.min_blocks;
+	policy.max_blocks = CTX.max_blocks;
+	policy.max_reports = CTX.max_reports;
+	policy.approved_price = CTX.reference_price;
+	policy.last_height = CTX.reference_height;
+	policy.last_price = CTX.reference_price;
+	oracle_policy_set(N_oracle_policy, &policy, oracle_policy_nvm_write);
+	G_io_apdu_buffer[0] = 1;
+	return 1;
+}
+
+static const review_field_t oracle_policy_fields[] = {
+	{"Oracle Key", review_format_address, global.oraclePolicyContext.key, NULL},
+	{"Reference Price", review_format_u64, &global.oraclePolicyContext.reference_price, NULL},
+	{"Max Change (bps)", review_format_u32, &global.oraclePolicyContext.max_delta_bps, NULL},
+	{"After Block", review_format_u64, &global.oraclePolicyContext.reference_height, NULL},
+	{"Min Blocks Apart", review_format_u32, &global.oraclePolicyContext.min_blocks, NULL},
+	{"Max Blocks Apart", review_format_u32, &global.oraclePolicyContext.max_blocks, NULL},
+	{"Reports Allowed", review_format_u32, &global.oraclePolicyContext.max_reports, NULL},
+};
+
+// oracle_policy_status responds with whether the policy is enabled (1 byte),
+// its bounds (4 bytes each), the approved price and the last height and
+// price signed (8 bytes each), the number of reports signed under it
+// (4 bytes), all little-endian, and the public key of the oracle
+// (32 bytes).
+static void oracle_policy_status(void) {
+	const oraclePolicy_t *policy = N_oracle_policy;
+	uint8_t *out = G_io_apdu_buffer;
+	uint32_t fields32[] = {policy->max_delta_bps, policy->min_blocks, policy->max_blocks, policy->max_reports};
+	uint64_t fields64[] = {policy->approved_price, policy->last_height, policy->last_price};
+
+	*out++ = policy->enabled == 1;
+	for (uint8_t i = 0; i < 4; i++) {
+		for (uint8_t j = 0; j < 4; j++) {
+			*out++ = fields32[i] >> (8 * j);
+		}
+	}
+	for (uint8_t i = 0; i < 3; i++) {
+		for (uint8_t j = 0; j < 8; j++) {
+			*out++ = fields64[i] >> (8 * j);
+		}
+	}
+	for (uint8_t j = 0; j < 4; j++) {
+		*out++ = policy->signed_count >> (8 * j);
+	}
+	memmove(out, policy->public_key, sizeof(policy->public_key));
+	out += sizeof(policy->public_key);
+	io_exchange_with_code(SW_OK, out - G_io_apdu_buffer);
+}
+
+// handle_oracle_policy sets (P1 = 0x00), disables (P1 = 0x01) or reads
+// (P1 = 0x02) the oracle policy. Setting it takes the maximum price change
+// in basis points, the minimum and maximum number of blocks between reports
+// and the number of reports to sign before it must be approved again
+// (4 bytes each), then the height the first report follows and the price
+// every report is checked against (8 bytes each), all little-endian, and
+// must be approved on the device.
+// Disabling it needs no approval, as it only takes a capability away.
+void handle_oracle_policy(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                          __attribute__((unused)) volatile unsigned int *tx) {
+	switch (p1) {
+	case P1_ORACLE_POLICY_SET: {
+		oraclePolicy_t bounds;
+		if (!save_oracle_policy_context(p1, p2, dataBuffer, dataLength, &CTX)) {
+			THROW(SW_INVALID_PARAM);
+		}
+		memset(&bounds, 0, sizeof(bounds));
+		bounds.max_delta_bps = CTX.max_delta_bps;
+		bounds.min_blocks = CTX.min_blocks;
+		bounds.max_blocks = CTX.max_blocks;
+		bounds.max_reports = CTX.max_reports;
+		bounds.approved_price = CTX.reference_price;
+		if (!oracle_policy_valid(&bounds)) {
+			THROW(SW_INVALID_PARAM);
+		}
+		CTX.key[0] = 0;
+#ifdef HELIUM_TESTNET
+		CTX.key[1] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+		CTX.key[1] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+		get_pubkey_bytes(&CTX.path, &CTX.key[2]);
+		ui_review_start(oracle_policy_fields, REVIEW_FIELD_COUNT(oracle_policy_fields), "Sign reports unattended?", oracle_policy_commit, NULL);
+		*flags |= IO_ASYNCH_REPLY;
+		break;
+	}
+	case P1_ORACLE_POLICY_DISABLE:
+		oracle_policy_disable(N_oracle_policy, oracle_policy_nvm_write);
+		io_exchange_with_code(SW_OK, 0);
+		break;
+	case P1_ORACLE_POLICY_GET:
+		oracle_policy_status();
+		break;
+	default:
+		THROW(SW_INVALID_PARAM);
+	}
+}
+
+// handle_sign_price_oracle_txn signs a price_oracle_v1 report, 8 bytes of
+// price then 8 bytes of block height (little-endian), without any review,
+// if the oracle policy allows it. The reply is the signed transaction.
+void handle_sign_price_oracle_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength,
+                                  __attribute__((unused)) volatile unsigned int *flags,
+                                  __attribute__((unused)) volatile unsigned int *tx) {
+	priceOracleContext_t *ctx = &global.priceOracleContext;
+	const oraclePolicy_t *policy = N_oracle_policy;
+
+	if (!save_price_oracle_context(p1, p2, dataBuffer, dataLength, ctx)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	if (policy->enabled != 1) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	if (!oracle_policy_allows(policy, ctx->price, ctx->block_height)) {
+		THROW(SW_POLICY_VIOLATION);
+	}
+	ctx->path = policy->path;
+	memmove(ctx->public_key, policy->public_key, sizeof(ctx->public_key));
+	oracle_policy_record(N_oracle_policy, ctx->price, ctx->block_height, oracle_policy_nvm_write);
+	io_exchange_with_code(SW_OK, create_helium_price_oracle_txn(&ctx->path));
+}
@@ -0,0 +1,225 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include <cx.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "helium_settings.h"
+#include "address_book.h"
+#include "response.h"
+#include "review_summary.h"
+
+#define CTX global.displayContext
+#define SUMMARY global.reviewSummaryContext
+
+// review_load_summary formats each value here before adding it to the
+// summary, clear of the start of the buffer, which review_format_address
+// uses as its own scratchpad.
+#define SUMMARY_SCRATCH (&G_io_apdu_buffer[128])
+
+reviewState_t review;
+
+// A transaction pre-signed during the review waits in the outbound queue
+// (see response.h). The host cannot read it from there until the user
+// approves it: GET_RESPONSE is refused while a review is active, any other
+// command ends the review, and a review that ends without approval empties
+// the queue.
+enum {
+	PRESIGN_NONE,
+	PRESIGN_PENDING,
+	PRESIGN_READY,
+};
+
+static uint8_t presign_state;
+
+uint8_t review_format_hnt(uint8_t *dst, const void *value) {
+	// pretty_print_hnt counts the characters it moved rather than the ones
+	// it wrote, so measure the result instead.
+	pretty_print_hnt(dst, *(const uint64_t *)value);
+	return strlen((const char *)dst);
+}
+
+uint8_t review_format_u64(uint8_t *dst, const void *value) {
+	return bin2dec(dst, *(const uint64_t *)value);
+}
+
+uint8_t review_format_u32(uint8_t *dst, const void *value) {
+	return bin2dec(dst, *(const uint32_t *)value);
+}
+
+uint8_t review_format_memo(uint8_t *dst, const void *value) {
+	return u64_to_base64(dst, *(const uint64_t *)value);
+}
+
+// review_format_address renders a 34-byte key, as sent by the companion app,
+// as a Base58Check address.
+uint8_t review_format_address(uint8_t *dst, const void *value) {
+	cx_sha256_t hash;
+	unsigned char hash_buffer[32];
+	size_t output_len = sizeof(CTX.fullStr) - 1;
+	// use the G_io_apdu buffer as a scratchpad to minimize stack usage
+	uint8_t * address_with_check = G_io_apdu_buffer;
+
+	memmove(address_with_check, value, SIZEOF_B58_KEY);
+	cx_sha256_init(&hash);
+	cx_hash(&hash.header, CX_LAST, address_with_check, SIZEOF_B58_KEY, hash_buffer, 32);
+	cx_sha256_init(&hash);
+	cx_hash(&hash.header, CX_LAST, hash_buffer, 32, hash_buffer, 32);
+	memmove(&address_with_check[SIZEOF_B58_KEY], hash_buffer, SIZE_OF_SHA_CHECKSUM);
+	btchip_encode_base58(address_with_check, SIZEOF_B58_KEY + SIZE_OF_SHA_CHECKSUM, dst, &output_len);
+	dst[output_len] = '\0';
+	return output_len;
+}
+
+// review_format_recipient shows the label of payees found in the on-device
+// address book, and the full address of any other payee.
+uint8_t review_format_recipient(uint8_t *dst, const void *value) {
+	const char *label = address_book_label(value);
+	if (label == NULL) {
+		return review_format_address(dst, value);
+	}
+	uint8_t len = review_format_text(dst, label);
+	memmove(&dst[len], " (trusted)", sizeof(" (trusted)"));
+	return len + sizeof(" (trusted)") - 1;
+}
+
+uint8_t review_format_text(uint8_t *dst, const void *value) {
+	uint8_t len = strnlen((const char *)value, ADDRESS_BOOK_LABEL_LEN - 1);
+	memmove(dst, value, len);
+	dst[len] = '\0';
+	return len;
+}
+
+void review_load_field(uint8_t index) {
+	const review_field_t *field = &review.fields[index];
+	review_format_fn_t *format = (review_format_fn_t *)PIC(field->format);
+
+	review.index = index;
+	strncpy(review.title, (const char *)PIC(field->title), sizeof(review.title) - 1);
+	review.title[sizeof(review.title) - 1] = '\0';
+
+	uint8_t len = format(CTX.fullStr, PIC(field->value));
+	CTX.fullStr[len] = '\0';
+	CTX.fullStr_len = len;
+}
+
+bool review_load_summary(void) {
+	reviewSummary_t summary;
+	bool any = false;
+
+	review_summary_init(&summary, SUMMARY.summary, sizeof(SUMMARY.summary));
+	for (uint8_t i = 0; i < review.count; i++) {
+		const review_field_t *field = &review.fields[i];
+		review_format_fn_t *format = (review_format_fn_t *)PIC(field->format);
+		if (field->summary == NULL) {
+			// fixed text, such as who signs, changes what the approval
+			// means, so a summary that leaves it out is not shown
+			if (format == review_format_text) {
+				return false;
+			}
+			continue;
+		}
+		// most transactions carry no memo, so only one that is set is shown
+		if (format == review_format_memo && *(const uint64_t *)PIC(field->value) == 0) {
+			continue;
+		}
+		// a trusted payee is shown by its label, anything else whole
+		format(SUMMARY_SCRATCH, PIC(field->value));
+		review_summary_add(&summary, (const char *)PIC(field->summary), (const char *)SUMMARY_SCRATCH);
+		any = true;
+	}
+	if (!any || !review_summary_fits(&summary)) {
+		return false;
+	}
+	SUMMARY.summary_len = summary.len;
+	return true;
+}
+
+void review_load_prompt(void) {
+	strncpy(review.title, (const char *)PIC(review.prompt), sizeof(review.title) - 1);
+	review.title[sizeof(review.title) - 1] = '\0';
+}
+
+void review_init(const review_field_t *fields, uint8_t count, const char *prompt, review_sign_fn_t *sign, const accountPath_t *path) {
+	review_wipe();
+	review.fields = fields;
+	review.count = count;
+	review.prompt = prompt;
+	review.sign = sign;
+	review.condensed = false;
+	if (path != NULL) {
+		review.path = *path;
+	} else {
+		memset(&review.path, 0, sizeof(review.path));
+	}
+}
+
+void ui_review_start(const review_field_t *fields, uint8_t count, const char *prompt, review_sign_fn_t *sign, const accountPath_t *path) {
+	review_init(fields, count, prompt, sign, path);
+	ui_review_display();
+}
+
+void review_sign_start(const review_field_t *fields, uint8_t count, review_sign_fn_t *sign, const accountPath_t *path) {
+	review_init(fields, count, REVIEW_PROMPT_SIGN, sign, path);
+	review.condensed = settings_expert_review() && review_load_summary();
+	ui_review_display();
+	// wait for the first ticker, so that the first screen is drawn before
+	// the derivation and signature hold up the UI
+	presign_state = PRESIGN_PENDING;
+}
+
+// review_presign runs the sign function and leaves its whole response, part
+// of which it may have queued itself, in the outbound queue.
+static void review_presign(void) {
+	response_reset();
+	uint32_t len = review.sign(&review.path);
+	response_append(G_io_apdu_buffer, len);
+	memset(G_io_apdu_buffer, 0, len);
+	presign_state = PRESIGN_READY;
+}
+
+void review_ticker(void) {
+	if (presign_state != PRESIGN_PENDING) {
+		return;
+	}
+	review_presign();
+}
+
+bool review_active(void) {
+	return review.sign != NULL;
+}
+
+void review_wipe(void) {
+	if (review_active()) {
+		response_reset();
+	}
+	presign_state = PRESIGN_NONE;
+	review.sign = NULL;
+}
+
+void review_validate(bool approved) {
+	if (approved) {
+		if (presign_state != PRESIGN_READY) {
+			// approved before the first ticker, or not a transaction
+			review_presign();
+		}
+		// the response goes through the outbound queue, so that it may
+		// take more than one APDU; ending the review first keeps it there
+		presign_state = PRESIGN_NONE;
+		review.sign = NULL;
+		io_exchange_response();
+	}
+	else {
+		review_wipe();
+		// make sure there's no data in the office
+		memset(G_io_apdu_buffer, 0, IO_APDU_BUFFER_SIZE);
+		// send a single 0 byte to differentiate from app not running
+		io_exchange_with_code(SW_OK, 1);
+	}
+
+	// Go back to main menu
+	ui_idle();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "save_context.h"
+
+#ifdef HELIUM_TESTNET
+#define TICKER_HNT "TNT"
+#define TICKER_HST "TST"
+#else
+#define TICKER_HNT "HNT"
+#define TICKER_HST "HST"
+#endif
+
+// A review_format_fn_t renders the value pointed to by 'value' as a
+// NUL-terminated string into 'dst' and returns the length of the string.
+typedef uint8_t review_format_fn_t(uint8_t *dst, const void *value);
+
+// A review_sign_fn_t builds and signs the transaction held in the command
+// context, leaving it in G_io_apdu_buffer. It returns the encoded length.
+// Responses longer than G_io_apdu_buffer are appended to the outbound queue
+// (see response.h) by the sign function itself, which then returns 0.
+typedef uint32_t review_sign_fn_t(const accountPath_t *path);
+
+// review_field_t describes one screen of a transaction review: a title and
+// the value shown beneath it. 'summary' is the short label of the field in
+// the summary of expert review mode, or NULL to leave it out of it; every
+// table spells it out. Field
+// tables live in flash, so the engine resolves every pointer with PIC before
+// using it.
+typedef struct {
+    const char *title;
+    review_format_fn_t *format;
+    const void *value;
+    const char *summary;
+} review_field_t;
+
+review_format_fn_t review_format_hnt;
+review_format_fn_t review_format_u64;
+review_format_fn_t review_format_u32;
+review_format_fn_t review_format_memo;
+review_format_fn_t review_format_address;
+review_format_fn_t review_format_recipient;
+review_format_fn_t review_format_text;
+
+#define REVIEW_PROMPT_SIGN "Sign transaction?"
+
+// Longest title is "HNT Paid to Old Owner".
+#define REVIEW_TITLE_MAX 24
+
+typedef struct {
+    const review_field_t *fields;
+    uint8_t count;
+    uint8_t index;
+    const char *prompt;
+    review_sign_fn_t *sign;
+    accountPath_t path;
+    char title[REVIEW_TITLE_MAX];
+    // the review opens on the summary in global.reviewSummaryContext
+    bool condensed;
+} reviewState_t;
+
+extern reviewState_t review;
+
+// review_load_field formats field 'index' of the current review into
+// review.title and global.displayContext.
+void review_load_field(uint8_t index);
+
+// review_load_summary formats the fields of the current review that have a
+// summary label into global.reviewSummaryContext, as one line (see
+// review_summary.h), leaving out a memo of zero. It returns false if there
+// are none, if they do not fit, or if a field of fixed text, such as
+// "Sign As", has no summary label.
+bool review_load_summary(void);
+
+// review_load_prompt puts the approval prompt of the current review into
+// review.title, which the approval screen displays.
+void review_load_prompt(void);
+
+// review_validate answers the pending sign request: with the signed
+// transaction when 'approved', with a single 0 byte otherwise. It then
+// returns to the idle screen.
+void review_validate(bool approved);
+
+// review_init resets the review state for a new review, dropping any
+// transaction pre-signed for the previous one.
+void review_init(const review_field_t *fields, uint8_t count, const char *prompt, review_sign_fn_t *sign, const accountPath_t *path);
+
+// ui_review_display shows the review set up by review_init: its fields one
+// after the other, then the approval screen, or its summary then the approval
+// screen if it is condensed, with the fields one step away. It is
+// implemented once per device in nanos_review.c and nanox_review.c.
+void ui_review_display(void);
+
+// ui_review_start displays 'fields' one after the other, followed by the
+// approval screen asking 'prompt'. On approval, sign(path) produces the
+// response; 'path' may be NULL when no key is involved.
+void ui_review_start(const review_field_t *fields, uint8_t count, const char *prompt, review_sign_fn_t *sign, const accountPath_t *path);
+
+// review_sign_start is ui_review_start for transaction reviews. Their sign
+// function has no side effects, so it is run on a ticker event while the
+// user is reviewing, and approving only sends the stored result. In expert
+// review mode, they open on their summary if they have one.
+void review_sign_start(const review_field_t *fields, uint8_t count, review_sign_fn_t *sign, const accountPath_t *path);
+
+// review_ticker does the pending pre-signing, if any. It is called on every
+// ticker event.
+void review_ticker(void);
+
+// review_active returns whether a review is waiting for the user.
+bool review_active(void);
+
+// review_wipe ends the review, emptying the outbound queue if the review
+// was still active, as it may hold its pre-signed transaction. ui_idle calls
+// it, so it also runs on reject and after a reset. An approved response has
+// already ended the review, so it stays queued.
+void review_wipe(void);
+
+#define REVIEW_FIELD_COUNT(fields) (sizeof(fields) / sizeof((fields)[0]))
@@ -0,0 +1,182 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include <cx.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "save_context.h"
+#include "fee.h"
+
+// signRoutingTxn signs a routing_v1 transaction for an OUI owned by the
+// device key. An XOR filter can take up to 100 KB, so it is streamed
+// through the signature's running hash rather than held:
+//
+//   P1_ROUTING_START   the request described in save_context.h. Updates
+//                      without a filter go to the review right away.
+//   P1_ROUTING_FILTER  the next bytes of the filter, in order. The reply is
+//                      empty until the last one, which starts the review.
+//
+// The review shows the filter's length and SHA-256, in Base64, for the user
+// to compare with the ones the host shows. On approval the reply is the
+// 64-byte signature of the transaction.
+
+static routingContext_t routing;
+static bool routing_streaming;
+static cx_sha256_t filter_hash;
+
+static uint8_t format_digest(uint8_t *dst, const void *value) {
+	return bytes_to_base64(dst, value, 32);
+}
+
+static const review_field_t routing_routers_fields[] = {
+	{"OUI", review_format_u32, &routing.oui, NULL},
+	{"Update", review_format_text, "Routers", NULL},
+	{"Data Credit Fee", review_format_u64, &routing.fee, NULL},
+	{"Nonce", review_format_u64, &routing.nonce, NULL},
+	{"Router 1", review_format_recipient, routing.routers[0], NULL},
+	{"Router 2", review_format_recipient, routing.routers[1], NULL},
+	{"Router 3", review_format_recipient, routing.routers[2], NULL},
+};
+
+static const review_field_t routing_new_xor_fields[] = {
+	{"OUI", review_format_u32, &routing.oui, NULL},
+	{"Update", review_format_text, "New XOR Filter", NULL},
+	{"Filter Bytes", review_format_u32, &routing.filter_length, NULL},
+	{"Filter SHA-256", format_digest, routing.filter_digest, NULL},
+	{"Data Credit Fee", review_format_u64, &routing.fee, NULL},
+	{"Nonce", review_format_u64, &routing.nonce, NULL},
+};
+
+static const review_field_t routing_update_xor_fields[] = {
+	{"OUI", review_format_u32, &routing.oui, NULL},
+	{"Update", review_format_text, "Replace XOR Filter", NULL},
+	{"Filter Index", review_format_u32, &routing.xor_index, NULL},
+	{"Filter Bytes", review_format_u32, &routing.filter_length, NULL},
+	{"Filter SHA-256", format_digest, routing.filter_digest, NULL},
+	{"Data Credit Fee", review_format_u64, &routing.fee, NULL},
+	{"Nonce", review_format_u64, &routing.nonce, NULL},
+};
+
+static const review_field_t routing_subnet_fields[] = {
+	{"OUI", review_format_u32, &routing.oui, NULL},
+	{"Update", review_format_text, "Request Subnet", NULL},
+	{"Subnet Size", review_format_u32, &routing.subnet_size, NULL},
+	{"Staking Fee", review_format_u64, &routing.staking_fee, NULL},
+	{"Data Credit Fee", review_format_u64, &routing.fee, NULL},
+	{"Nonce", review_format_u64, &routing.nonce, NULL},
+};
+
+void routing_reset(void) {
+	routing_streaming = false;
+}
+
+static uint32_t routing_size(void) {
+	return size_helium_routing_txn(&routing);
+}
+
+static uint32_t routing_sign(__attribute__((unused)) const accountPath_t *path) {
+	return create_helium_routing_txn(&routing);
+}
+
+static void routing_review(void) {
+	switch (routing.update) {
+	case ROUTING_UPDATE_ROUTERS:
+		ui_review_start(routing_routers_fields,
+		                REVIEW_FIELD_COUNT(routing_routers_fields) - (ROUTING_ROUTERS_MAX - routing.router_count),
+		                REVIEW_PROMPT_SIGN, routing_sign, &routing.path);
+		break;
+	case ROUTING_NEW_XOR:
+		ui_review_start(routing_new_xor_fields, REVIEW_FIELD_COUNT(routing_new_xor_fields), REVIEW_PROMPT_SIGN, routing_sign, &routing.path);
+		break;
+	case ROUTING_UPDATE_XOR:
+		ui_review_start(routing_update_xor_fields, REVIEW_FIELD_COUNT(routing_update_xor_fields), REVIEW_PROMPT_SIGN, routing_sign, &routing.path);
+		break;
+	default:
+		ui_review_start(routing_subnet_fields, REVIEW_FIELD_COUNT(routing_subnet_fields), REVIEW_PROMPT_SIGN, routing_sign, &routing.path);
+		break;
+	}
+}
+
+// routing_start returns whether a filter is expected.
+static bool routing_start(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength) {
+	routing_streaming = false;
+	if (!save_routing_context(p1, p2, dataBuffer, dataLength, &routing)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	// only a subnet is staked for
+	bool valid = routing.update == ROUTING_REQUEST_SUBNET || routing.staking_fee == 0;
+	switch (routing.update) {
+	case ROUTING_UPDATE_ROUTERS:
+		valid = valid && routing.router_count > 0;
+		break;
+	case ROUTING_UPDATE_XOR:
+		valid = valid && routing.xor_index <= ROUTING_XOR_INDEX_MAX;
+		// fall through
+	case ROUTING_NEW_XOR:
+		valid = valid && routing.filter_length > 0 && routing.filter_length <= ROUTING_FILTER_MAX;
+		break;
+	case ROUTING_REQUEST_SUBNET:
+		valid = valid && routing.subnet_size > 0;
+		break;
+	}
+	if (!valid) {
+		THROW(SW_INVALID_PARAM);
+	}
+
+	fee_fill(&routing.fee, routing_size);
+	start_helium_routing_txn(&routing);
+	if (routing.filter_length == 0) {
+		routing_review();
+		return false;
+	}
+	cx_sha256_init(&filter_hash);
+	routing_streaming = true;
+	return true;
+}
+
+// routing_filter returns whether the filter is complete.
+static bool routing_filter(uint8_t *dataBuffer, uint16_t dataLength) {
+	if (!routing_streaming) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	if (dataLength == 0 || dataLength > routing.filter_length - routing.filter_received) {
+		routing_streaming = false;
+		THROW(SW_INVALID_PARAM);
+	}
+	cx_hash(&filter_hash.header, 0, dataBuffer, dataLength, NULL, 0);
+	stream_helium_routing_filter(&routing, dataBuffer, dataLength);
+	if (routing.filter_received < routing.filter_length) {
+		return false;
+	}
+	cx_hash(&filter_hash.header, CX_LAST, NULL, 0, routing.filter_digest, sizeof(routing.filter_digest));
+	routing_streaming = false;
+	routing_review();
+	return true;
+}
+
+// handle_sign_routing_txn is the entry point for the signRoutingTxn command,
+// which P1 steps through as described above.
+void handle_sign_routing_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                             __attribute__((unused)) volatile unsigned int *tx) {
+	switch (p1) {
+	case P1_ROUTING_START:
+		if (routing_start(p1, p2, dataBuffer, dataLength)) {
+			io_exchange_with_code(SW_OK, 0);
+		} else {
+			*flags |= IO_ASYNCH_REPLY;
+		}
+		break;
+	case P1_ROUTING_FILTER:
+		if (routing_filter(dataBuffer, dataLength)) {
+			*flags |= IO_ASYNCH_REPLY;
+		} else {
+			io_exchange_with_code(SW_OK, 0);
+		}
+		break;
+	default:
+		THROW(SW_INVALID_PARAM);
+	}
+}
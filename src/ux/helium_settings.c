@@ -0,0 +1,20 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <os.h>
+#include "helium_settings.h"
+
+typedef struct {
+	uint8_t expert_review;
+} settings_t;
+
+const settings_t N_settings_real;
+#define N_settings ((settings_t *)PIC(&N_settings_real))
+
+bool settings_expert_review(void) {
+	return N_settings->expert_review == 1;
+}
+
+void settings_set_expert_review(bool enabled) {
+	uint8_t value = enabled;
+	nvm_write(&N_settings->expert_review, &value, sizeof(value));
+}
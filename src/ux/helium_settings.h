@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdbool.h>
+
+// The settings are changed from the main menu and kept in NVM, so that they
+// survive power cycles. They all start out off.
+
+// settings_expert_review returns whether transaction reviews open on a
+// one-screen summary (see review_summary.h) rather than on their fields.
+bool settings_expert_review(void);
+
+void settings_set_expert_review(bool enabled);
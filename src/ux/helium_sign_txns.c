@@ -0,0 +1,339 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "save_context.h"
+#include "fee.h"
+
+// Each signing command saves its request into the command context, computes
+// the fee if the request left it at 0 (see fee.h), and hands a table of
+// fields to the review engine. The tables are the only place where the
+// screens of a transaction are defined, for both Nano S and Nano X, including
+// the summary of expert review mode: the amounts, the addresses, any memo
+// and the fee, where there are such fields.
+
+static const review_field_t payment_fields[] = {
+	{"Amount " TICKER_HNT, review_format_hnt, &global.paymentContext.amount, "Pay " TICKER_HNT},
+	{"Recipient Address", review_format_recipient, global.paymentContext.payee, "To"},
+	{"Payment Memo", review_format_memo, &global.paymentContext.memo, "Memo"},
+	{"Data Credit Fee", review_format_u64, &global.paymentContext.fee, "Fee"},
+};
+
+void handle_sign_payment_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                             __attribute__((unused)) volatile unsigned int *tx) {
+	if (!save_payment_context(p1, p2, dataBuffer, dataLength, &global.paymentContext)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&global.paymentContext.fee, size_helium_pay_txn);
+	review_sign_start(payment_fields, REVIEW_FIELD_COUNT(payment_fields), create_helium_pay_txn, &global.paymentContext.path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+static const review_field_t burn_fields[] = {
+	{"Burn " TICKER_HNT, review_format_hnt, &global.burnContext.amount, "Burn " TICKER_HNT},
+	{"Recipient Address", review_format_recipient, global.burnContext.payee, "For"},
+	{"Burn Memo", review_format_memo, &global.burnContext.memo, "Memo"},
+	{"Data Credit Fee", review_format_u64, &global.burnContext.fee, "Fee"},
+};
+
+void handle_burn_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                     __attribute__((unused)) volatile unsigned int *tx) {
+	if (!save_burn_context(p1, p2, dataBuffer, dataLength, &global.burnContext)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&global.burnContext.fee, size_helium_burn_txn);
+	review_sign_start(burn_fields, REVIEW_FIELD_COUNT(burn_fields), create_helium_burn_txn, &global.burnContext.path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+static const review_field_t transfer_sec_fields[] = {
+	{"Amount " TICKER_HST, review_format_hnt, &global.transferSecContext.amount, "Pay " TICKER_HST},
+	{"Recipient Address", review_format_recipient, global.transferSecContext.payee, "To"},
+	{"Data Credit Fee", review_format_u64, &global.transferSecContext.fee, "Fee"},
+};
+
+void handle_sign_transfer_sec_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                                  __attribute__((unused)) volatile unsigned int *tx) {
+	if (!save_transfer_sec_context(p1, p2, dataBuffer, dataLength, &global.transferSecContext)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&global.transferSecContext.fee, size_helium_transfer_sec);
+	review_sign_start(transfer_sec_fields, REVIEW_FIELD_COUNT(transfer_sec_fields), create_helium_transfer_sec, &global.transferSecContext.path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+// Validator reviews name validators and owners by address, so their summary
+// holds each of those whole.
+static const review_field_t stake_validator_fields[] = {
+	{"Stake " TICKER_HNT, review_format_hnt, &global.stakeValidatorContext.stake, "Stake " TICKER_HNT},
+	{"Stake Address", review_format_address, global.stakeValidatorContext.address, "On"},
+	{"Data Credit Fee", review_format_u64, &global.stakeValidatorContext.fee, "Fee"},
+};
+
+void handle_stake_validator_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                                __attribute__((unused)) volatile unsigned int *tx) {
+	if (!save_stake_validator_context(p1, p2, dataBuffer, dataLength, &global.stakeValidatorContext)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&global.stakeValidatorContext.fee, size_helium_stake_txn);
+	review_sign_start(stake_validator_fields, REVIEW_FIELD_COUNT(stake_validator_fields), create_helium_stake_txn, &global.stakeValidatorContext.path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+static const review_field_t unstake_validator_fields[] = {
+	{"Unstake " TICKER_HNT, review_format_hnt, &global.unstakeValidatorContext.stake_amount, "Unstake " TICKER_HNT},
+	{"Stake Release Height", review_format_u64, &global.unstakeValidatorContext.stake_release_height, "At Block"},
+	{"Unstake Address", review_format_address, global.unstakeValidatorContext.address, "From"},
+	{"Data Credit Fee", review_format_u64, &global.unstakeValidatorContext.fee, "Fee"},
+};
+
+void handle_unstake_validator_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                                  __attribute__((unused)) volatile unsigned int *tx) {
+	if (!save_unstake_validator_context(p1, p2, dataBuffer, dataLength, &global.unstakeValidatorContext)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&global.unstakeValidatorContext.fee, size_helium_unstake_txn);
+	review_sign_start(unstake_validator_fields, REVIEW_FIELD_COUNT(unstake_validator_fields), create_helium_unstake_txn, &global.unstakeValidatorContext.path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+static const review_field_t transfer_validator_fields[] = {
+	{"Transfer " TICKER_HNT " Stake", review_format_hnt, &global.transferValidatorContext.stake_amount, "Transfer " TICKER_HNT},
+	{TICKER_HNT " Paid to Old Owner", review_format_hnt, &global.transferValidatorContext.payment_amount, "For " TICKER_HNT},
+	{"Old Owner", review_format_address, global.transferValidatorContext.old_owner, "Old Owner"},
+	{"New Owner", review_format_address, global.transferValidatorContext.new_owner, "New Owner"},
+	{"Old Address", review_format_address, global.transferValidatorContext.old_address, "Old Address"},
+	{"New Address", review_format_address, global.transferValidatorContext.new_address, "New Address"},
+	{"Data Credit Fee", review_format_u64, &global.transferValidatorContext.fee, "Fee"},
+};
+
+// transfer_validator_both_fields adds a screen to say that the device signs
+// for both owners, when the request carries both of their paths.
+static const review_field_t transfer_validator_both_fields[] = {
+	{"Transfer " TICKER_HNT " Stake", review_format_hnt, &global.transferValidatorContext.stake_amount, "Transfer " TICKER_HNT},
+	{TICKER_HNT " Paid to Old Owner", review_format_hnt, &global.transferValidatorContext.payment_amount, "For " TICKER_HNT},
+	{"Old Owner", review_format_address, global.transferValidatorContext.old_owner, "Old Owner"},
+	{"New Owner", review_format_address, global.transferValidatorContext.new_owner, "New Owner"},
+	{"Old Address", review_format_address, global.transferValidatorContext.old_address, "Old Address"},
+	{"New Address", review_format_address, global.transferValidatorContext.new_address, "New Address"},
+	{"Data Credit Fee", review_format_u64, &global.transferValidatorContext.fee, "Fee"},
+	{"Sign As", review_format_text, "Both Owners", "As"},
+};
+
+// owns_key returns whether 'key', in the 34-byte format of the sign
+// requests, is the key of 'path' on this device.
+static bool owns_key(const accountPath_t *path, const unsigned char *key) {
+	unsigned char own[SIZEOF_HELIUM_KEY];
+#ifdef HELIUM_TESTNET
+	own[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+	own[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+	get_pubkey_bytes(path, &own[1]);
+	return memcmp(own, &key[1], SIZEOF_HELIUM_KEY) == 0;
+}
+
+void handle_transfer_validator_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                                   __attribute__((unused)) volatile unsigned int *tx) {
+	transferValidatorContext_t *ctx = &global.transferValidatorContext;
+	if (!save_transfer_validator_context(p1, p2, dataBuffer, dataLength, ctx)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&ctx->fee, size_helium_transfer_validator_txn);
+	if (!ctx->both_owners) {
+		review_sign_start(transfer_validator_fields, REVIEW_FIELD_COUNT(transfer_validator_fields), create_helium_transfer_validator_txn, &ctx->path);
+	} else {
+		// both signatures are made after a single review, so refuse the
+		// request if either owner is not held here
+		if (!owns_key(&ctx->path, ctx->old_owner) || !owns_key(&ctx->new_owner_path, ctx->new_owner)) {
+			THROW(SW_INVALID_PARAM);
+		}
+		review_sign_start(transfer_validator_both_fields, REVIEW_FIELD_COUNT(transfer_validator_both_fields), create_helium_transfer_validator_txn, &ctx->path);
+	}
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+// format_channel_id renders the id of the state channel being opened in
+// Base64; the id of a batch entry is in the same context by then.
+static uint8_t format_channel_id(uint8_t *dst, const void *value) {
+	const stateChannelOpenContext_t *ctx = value;
+	return bytes_to_base64(dst, ctx->id, ctx->id_len);
+}
+
+static const review_field_t state_channel_open_fields[] = {
+	{"Open Channel DC", review_format_u64, &global.stateChannelOpenContext.amount, NULL},
+	{"OUI", review_format_u64, &global.stateChannelOpenContext.oui, NULL},
+	{"Expires Within", review_format_u64, &global.stateChannelOpenContext.expire_within, NULL},
+	{"Channel ID", format_channel_id, &global.stateChannelOpenContext, NULL},
+	{"Nonce", review_format_u64, &global.stateChannelOpenContext.nonce, NULL},
+	{"Data Credit Fee", review_format_u64, &global.stateChannelOpenContext.fee, NULL},
+};
+
+void handle_state_channel_open_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                                   __attribute__((unused)) volatile unsigned int *tx) {
+	stateChannelOpenContext_t *ctx = &global.stateChannelOpenContext;
+	if (!save_state_channel_open_context(p1, p2, dataBuffer, dataLength, ctx)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	// amount and expire_within are int64 on the chain
+	if (ctx->amount > INT64_MAX || ctx->expire_within == 0 || ctx->expire_within > INT64_MAX || ctx->id_len == 0) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&ctx->fee, size_helium_state_channel_open_txn);
+	review_sign_start(state_channel_open_fields, REVIEW_FIELD_COUNT(state_channel_open_fields), create_helium_state_channel_open_txn, &ctx->path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+// The filter of an oui_v1 request does not fit on a screen, so its SHA-256
+// is shown instead, in Base64, for the user to compare with the host's.
+static uint8_t oui_filter_digest[32];
+
+static uint8_t format_digest(uint8_t *dst, const void *value) {
+	return bytes_to_base64(dst, value, 32);
+}
+
+// format_oui_payer shows that the owner pays when the request names no
+// payer.
+static uint8_t format_oui_payer(uint8_t *dst, const void *value) {
+	static const unsigned char no_payer[SIZEOF_B58_KEY] = {0};
+	if (memcmp(value, no_payer, sizeof(no_payer)) == 0) {
+		return review_format_text(dst, "Owner");
+	}
+	return review_format_address(dst, value);
+}
+
+// The router screens come last, so that the ones of absent routers are cut
+// off the count.
+static const review_field_t oui_fields[] = {
+	{"OUI", review_format_u64, &global.ouiContext.oui, NULL},
+	{"Subnet Size", review_format_u32, &global.ouiContext.requested_subnet_size, NULL},
+	{"Staking Fee", review_format_u64, &global.ouiContext.staking_fee, NULL},
+	{"Data Credit Fee", review_format_u64, &global.ouiContext.fee, NULL},
+	{"Payer", format_oui_payer, global.ouiContext.payer, NULL},
+	{"Filter Bytes", review_format_u32, &global.ouiContext.filter_len, NULL},
+	{"Filter SHA-256", format_digest, oui_filter_digest, NULL},
+	{"Router 1", review_format_recipient, global.ouiContext.addresses[0], NULL},
+	{"Router 2", review_format_recipient, global.ouiContext.addresses[1], NULL},
+	{"Router 3", review_format_recipient, global.ouiContext.addresses[2], NULL},
+};
+
+// oui_both_fields adds a screen to say that the device signs as the payer
+// too, when the request carries its path.
+static const review_field_t oui_both_fields[] = {
+	{"Sign As", review_format_text, "Owner and Payer", NULL},
+	{"OUI", review_format_u64, &global.ouiContext.oui, NULL},
+	{"Subnet Size", review_format_u32, &global.ouiContext.requested_subnet_size, NULL},
+	{"Staking Fee", review_format_u64, &global.ouiContext.staking_fee, NULL},
+	{"Data Credit Fee", review_format_u64, &global.ouiContext.fee, NULL},
+	{"Payer", format_oui_payer, global.ouiContext.payer, NULL},
+	{"Filter Bytes", review_format_u32, &global.ouiContext.filter_len, NULL},
+	{"Filter SHA-256", format_digest, oui_filter_digest, NULL},
+	{"Router 1", review_format_recipient, global.ouiContext.addresses[0], NULL},
+	{"Router 2", review_format_recipient, global.ouiContext.addresses[1], NULL},
+	{"Router 3", review_format_recipient, global.ouiContext.addresses[2], NULL},
+};
+
+void handle_oui_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                    __attribute__((unused)) volatile unsigned int *tx) {
+	ouiContext_t *ctx = &global.ouiContext;
+	cx_sha256_t hash;
+	if (!save_oui_context(p1, p2, dataBuffer, dataLength, ctx)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	// a new OUI needs a router, a filter and a subnet
+	if (ctx->address_count == 0 || ctx->filter_len == 0 || ctx->requested_subnet_size == 0) {
+		THROW(SW_INVALID_PARAM);
+	}
+	cx_sha256_init(&hash);
+	cx_hash(&hash.header, CX_LAST, ctx->filter, ctx->filter_len, oui_filter_digest, sizeof(oui_filter_digest));
+	fee_fill(&ctx->fee, size_helium_oui_txn);
+
+	uint8_t absent = OUI_ADDRESSES_MAX - ctx->address_count;
+	if (!ctx->both_signers) {
+		review_sign_start(oui_fields, REVIEW_FIELD_COUNT(oui_fields) - absent, create_helium_oui_txn, &ctx->path);
+	} else {
+		// as for validator transfers, both signatures follow a single
+		// review, so the payer key must be held here
+		if (!owns_key(&ctx->payer_path, ctx->payer)) {
+			THROW(SW_INVALID_PARAM);
+		}
+		review_sign_start(oui_both_fields, REVIEW_FIELD_COUNT(oui_both_fields) - absent, create_helium_oui_txn, &ctx->path);
+	}
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+static const review_field_t update_gateway_oui_fields[] = {
+	{"Gateway", review_format_address, global.updateGatewayOuiContext.gateway, NULL},
+	{"New OUI", review_format_u64, &global.updateGatewayOuiContext.oui, NULL},
+	{"Gateway Nonce", review_format_u64, &global.updateGatewayOuiContext.nonce, NULL},
+	{"Data Credit Fee", review_format_u64, &global.updateGatewayOuiContext.fee, NULL},
+	{"Sign As", review_format_text, "Both Owners", NULL},
+};
+
+// handle_update_gateway_oui_txn signs as both the gateway owner and the OUI
+// owner, whose keys the transaction does not name; the chain checks them.
+void handle_update_gateway_oui_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                                   __attribute__((unused)) volatile unsigned int *tx) {
+	updateGatewayOuiContext_t *ctx = &global.updateGatewayOuiContext;
+	if (!save_update_gateway_oui_context(p1, p2, dataBuffer, dataLength, ctx)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&ctx->fee, size_helium_update_gateway_oui_txn);
+	review_sign_start(update_gateway_oui_fields, REVIEW_FIELD_COUNT(update_gateway_oui_fields), create_helium_update_gateway_oui_txn, &ctx->path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+// An HTLC is shown by its hashlock, in Base64 like a filter digest, and by
+// the block height after which the payer can take it back. With the amount,
+// the payee and the HTLC address, those would make a summary no quicker to
+// check than the fields, so HTLCs are always reviewed in full.
+static const review_field_t create_htlc_fields[] = {
+	{"Lock " TICKER_HNT, review_format_hnt, &global.createHtlcContext.amount, NULL},
+	{"Payee", review_format_recipient, global.createHtlcContext.payee, NULL},
+	{"Hashlock", format_digest, global.createHtlcContext.hashlock, NULL},
+	{"Timelock Block", review_format_u64, &global.createHtlcContext.timelock, NULL},
+	{"HTLC Address", review_format_address, global.createHtlcContext.address, NULL},
+	{"Nonce", review_format_u64, &global.createHtlcContext.nonce, NULL},
+	{"Data Credit Fee", review_format_u64, &global.createHtlcContext.fee, NULL},
+};
+
+void handle_create_htlc_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                            __attribute__((unused)) volatile unsigned int *tx) {
+	createHtlcContext_t *ctx = &global.createHtlcContext;
+	if (!save_create_htlc_context(p1, p2, dataBuffer, dataLength, ctx)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	if (ctx->amount == 0 || ctx->timelock == 0) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&ctx->fee, size_helium_create_htlc_txn);
+	review_sign_start(create_htlc_fields, REVIEW_FIELD_COUNT(create_htlc_fields), create_helium_create_htlc_txn, &ctx->path);
+	*flags |= IO_ASYNCH_REPLY;
+}
+
+static const review_field_t redeem_htlc_fields[] = {
+	{"Redeem HTLC", review_format_address, global.redeemHtlcContext.address, NULL},
+	{"Hashlock", format_digest, global.redeemHtlcContext.hashlock, NULL},
+	{"Data Credit Fee", review_format_u64, &global.redeemHtlcContext.fee, NULL},
+};
+
+// handle_redeem_htlc_txn checks the preimage against the hashlock the host
+// sent with it before anything is shown, to catch a host that mixed up its
+// HTLCs. The device cannot tie that hashlock to the HTLC at the address.
+void handle_redeem_htlc_txn(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags,
+                            __attribute__((unused)) volatile unsigned int *tx) {
+	redeemHtlcContext_t *ctx = &global.redeemHtlcContext;
+	if (!save_redeem_htlc_context(p1, p2, dataBuffer, dataLength, ctx)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	if (ctx->preimage_len == 0 || !htlc_preimage_matches(ctx->preimage, ctx->preimage_len, ctx->hashlock)) {
+		THROW(SW_INVALID_PARAM);
+	}
+	fee_fill(&ctx->fee, size_helium_redeem_htlc_txn);
+	review_sign_start(redeem_htlc_fields, REVIEW_FIELD_COUNT(redeem_htlc_fields), create_helium_redeem_htlc_txn, &ctx->path);
+	*flags |= IO_ASYNCH_REPLY;
+}
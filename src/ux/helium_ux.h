@@ -1,4 +1,5 @@
 #pragma once
+#include <stdbool.h>
 #include "ux.h"
 #include "../save_context.h"
 
@@ -32,3 +33,39 @@ void ui_idle(void);
 // within G_io_apdu_buffer (before the code is appended).
 void io_exchange_with_code(uint16_t code, uint16_t tx);
 
+// io_exchange_response sends the next chunk of the response queued with
+// response_append, with the status word telling whether more are left.
+void io_exchange_response(void);
+
+
+#if defined(TARGET_NANOS) && !defined(HAVE_UX_FLOW)
+
+// The scroller shows a 12-character window of the text given to
+// ui_scroll_start, such as global.displayContext.fullStr. The window is cut
+// out of the text when the element is sent to the screen, so scrolling only
+// moves its start.
+#define UI_SCROLL_WINDOW 12
+#define UI_SCROLL_USERID 0x10
+#define UI_SCROLL_TEXT(x, y, w) UI_TEXT(UI_SCROLL_USERID, x, y, w, global.displayContext.fullStr)
+
+// ui_scroll_start makes the 'len' characters of 'text' the text of the
+// scrolling screen about to be displayed, with the window at its start.
+// 'text' must stay unchanged while it is displayed.
+void ui_scroll_start(uint8_t *text, uint16_t len);
+
+// ui_scroll_prepro hides the left (userid 0x01) and right (userid 0x02)
+// arrows when the window is at either end of the string.
+const bagl_element_t *ui_scroll_prepro(const bagl_element_t *element);
+
+// ui_scroll_button handles the left and right buttons of a scrolling screen,
+// and returns false for any other event. Held buttons scroll faster the
+// longer they are held. 'text_index' is the index of the UI_SCROLL_TEXT
+// element within the screen; it must be the last element, so that only it is
+// redrawn while the arrows stay the same.
+bool ui_scroll_button(unsigned int button_mask, unsigned int button_mask_counter, uint8_t text_index);
+
+// ui_scroll_display sends a UI_SCROLL_TEXT element to the screen. It is
+// called from io_seproxyhal_display.
+void ui_scroll_display(const bagl_element_t *element);
+
+#endif
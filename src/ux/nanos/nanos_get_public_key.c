@@ -15,51 +15,27 @@
 
 // Define the comparison screen. This is where the user will compare the
 // public key (or address) on their device to the one shown on the computer.
+// The visible portion of the address is drawn by the shared scroller, which
+// also hides the left/right arrows at either end.
+#define UI_GET_PUBLIC_KEY_TEXT_INDEX 4
+
 static const bagl_element_t ui_getPublicKey[] = {
 	UI_BACKGROUND(),
 	UI_ICON_LEFT(0x01, BAGL_GLYPH_ICON_LEFT),
 	UI_ICON_RIGHT(0x02, BAGL_GLYPH_ICON_RIGHT),
 	UI_TEXT(0x00, 0, 12, 128, "Confirm Address"),
-	// The visible portion of the public key or address.
-	UI_TEXT(0x00, 0, 26, 128, CTX.partialStr),
+	UI_SCROLL_TEXT(0, 26, 128),
 };
 
-// Define the preprocessor for the comparison screen. As in signHash, this
-// preprocessor selectively hides the left/right arrows. The only difference
-// is that, since public keys and addresses have different lengths, checking
-// for the end of the string is slightly more complicated.
 static const bagl_element_t* ui_prepro_getPublicKey(const bagl_element_t *element) {
-	int fullSize =  CTX.fullStr_len;
-	if ((element->component.userid == 1 && CTX.displayIndex == 0) ||
-	    (element->component.userid == 2 && CTX.displayIndex == fullSize-12)) {
-		return NULL;
-	}
-	return element;
+	return ui_scroll_prepro(element);
 }
 
-// Define the button handler for the comparison screen. Again, this is nearly
-// identical to the signHash comparison button handler.
-static unsigned int ui_getPublicKey_button(unsigned int button_mask, __attribute__((unused)) unsigned int button_mask_counter) {
-	int fullSize = CTX.fullStr_len;
+static unsigned int ui_getPublicKey_button(unsigned int button_mask, unsigned int button_mask_counter) {
+	if (ui_scroll_button(button_mask, button_mask_counter, UI_GET_PUBLIC_KEY_TEXT_INDEX)) {
+		return 0;
+	}
 	switch (button_mask) {
-	case BUTTON_LEFT:
-	case BUTTON_EVT_FAST | BUTTON_LEFT: // SEEK LEFT
-		if (CTX.displayIndex > 0) {
-			CTX.displayIndex--;
-		}
-		memmove(CTX.partialStr, CTX.fullStr+CTX.displayIndex, 12);
-		UX_REDISPLAY();
-		break;
-
-	case BUTTON_RIGHT:
-	case BUTTON_EVT_FAST | BUTTON_RIGHT: // SEEK RIGHT
-		if (CTX.displayIndex < fullSize-12) {
-			CTX.displayIndex++;
-		}
-		memmove(CTX.partialStr, CTX.fullStr+CTX.displayIndex, 12);
-		UX_REDISPLAY();
-		break;
-
 	case BUTTON_EVT_RELEASED | BUTTON_LEFT | BUTTON_RIGHT: // PROCEED
 		// The user has finished comparing, so return to the main screen.
 		ui_idle();
@@ -72,8 +48,8 @@ static unsigned int ui_getPublicKey_button(unsigned int button_mask, __attribute
 // reads the command parameters, prepares and displays the approval screen,
 // and 
 void handle_get_public_key(uint8_t p1, uint8_t p2,
-                           __attribute__((unused)) uint8_t *dataBuffer,
-                           __attribute__((unused)) uint16_t dataLength,
+                           uint8_t *dataBuffer,
+                           uint16_t dataLength,
                            __attribute__((unused)) volatile unsigned int *flags,
                            __attribute__((unused)) volatile unsigned int *tx) {
 	size_t output_len;
@@ -81,6 +57,12 @@ void handle_get_public_key(uint8_t p1, uint8_t p2,
 	if ((p1 != P1_PUBKEY_DISPLAY_ON) && (p1 != P1_PUBKEY_DISPLAY_OFF)) {
 		THROW(SW_INVALID_PARAM);
 	}
+	// The account is P2, or the path follows the command (see
+	// save_account_path). It is read before the reply overwrites it.
+	accountPath_t path;
+	if (!save_account_path(p2, dataBuffer, dataLength, 0, &path)) {
+		THROW(SW_INVALID_PARAM);
+	}
 	uint16_t adpu_tx = 2;
 
 	G_io_apdu_buffer[0] = 0; // prepend 0 byte to signify b58 format
@@ -89,8 +71,7 @@ void handle_get_public_key(uint8_t p1, uint8_t p2,
 #else
 	G_io_apdu_buffer[1] = NETTYPE_MAIN | KEYTYPE_ED25519;
 #endif
-	uint8_t account = p2;
-	get_pubkey_bytes(account, &G_io_apdu_buffer[adpu_tx]);
+	get_pubkey_bytes(&path, &G_io_apdu_buffer[adpu_tx]);
 	adpu_tx += SIZE_OF_PUB_KEY_BIN;
 
 	cx_sha256_t hash;
@@ -112,9 +93,7 @@ void handle_get_public_key(uint8_t p1, uint8_t p2,
 			btchip_encode_base58(G_io_apdu_buffer, adpu_tx, CTX.fullStr, &output_len);
 			CTX.fullStr[51] = '\0';
 			CTX.fullStr_len = output_len;
-			memmove(CTX.partialStr, CTX.fullStr, 12);
-			CTX.partialStr[12] = '\0';
-			CTX.displayIndex = 0;
+			ui_scroll_start(CTX.fullStr, CTX.fullStr_len);
 
 			// Display the comparison screen.
 			UX_DISPLAY(ui_getPublicKey, ui_prepro_getPublicKey);
@@ -2,7 +2,10 @@
 
 #if defined(TARGET_NANOS) && !defined(HAVE_UX_FLOW)
 
+#include <string.h>
 #include "helium_ux.h"
+#include "helium_review.h"
+#include "helium_settings.h"
 #include "glyphs.h"
 #include "ux.h"
 
@@ -43,8 +46,23 @@ static const ux_menu_entry_t menu_about[] = {
 	UX_MENU_END,
 };
 
+static char expert_review_label[sizeof("Disabled")];
+
+static void menu_load_labels(void) {
+	strcpy(expert_review_label, settings_expert_review() ? "Enabled" : "Disabled");
+}
+
+// menu_toggle_expert_review switches between the summary and the full fields
+// as the first screen of transaction reviews, and stays on its entry.
+static void menu_toggle_expert_review(__attribute__((unused)) unsigned int userid) {
+	settings_set_expert_review(!settings_expert_review());
+	menu_load_labels();
+	UX_MENU_DISPLAY(1, menu_main, NULL);
+}
+
 static const ux_menu_entry_t menu_main[] = {
 	{NULL, NULL, 0, NULL, "Waiting for", "commands...", 0, 0},
+	{NULL, menu_toggle_expert_review, 0, NULL, "Expert review", expert_review_label, 0, 0},
 	{menu_about, NULL, 0, NULL, "About", NULL, 0, 0},
 	{NULL, os_sched_exit, 0, &C_icon_dashboard, "Quit app", NULL, 50, 29},
 	UX_MENU_END,
@@ -53,6 +71,8 @@ static const ux_menu_entry_t menu_main[] = {
 // ui_idle displays the main menu. Note that your app isn't required to use a
 // menu as its idle screen; you can define your own completely custom screen.
 void ui_idle(void) {
+	review_wipe();
+	menu_load_labels();
 	// The first argument is the starting index within menu_main, and the last
 	// argument is a preprocessor; I've never seen an app that uses either
 	// argument.
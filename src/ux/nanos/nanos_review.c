@@ -0,0 +1,141 @@
+#include "bolos_target.h"
+
+#if defined(TARGET_NANOS) && !defined(HAVE_UX_FLOW)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include <cx.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+
+static const bagl_element_t ui_signTxn_approve[] = {
+	UI_BACKGROUND(),
+	UI_ICON_LEFT(0x00, BAGL_GLYPH_ICON_CROSS),
+	UI_ICON_RIGHT(0x00, BAGL_GLYPH_ICON_CHECK),
+
+	UI_TEXT(0x00, 0, 18, 128, review.title),
+};
+
+static const bagl_element_t* ui_prepro_signTxn_approve(const bagl_element_t *element) {
+	return element;
+}
+
+static unsigned int ui_signTxn_approve_button(unsigned int button_mask, __attribute__((unused)) unsigned int button_mask_counter) {
+	switch (button_mask) {
+	case BUTTON_LEFT:
+	case BUTTON_EVT_FAST | BUTTON_LEFT: // REJECT
+		review_validate(false);
+		break;
+
+	case BUTTON_RIGHT:
+	case BUTTON_EVT_FAST | BUTTON_RIGHT: // APPROVE
+		review_validate(true);
+		break;
+
+	case BUTTON_EVT_RELEASED | BUTTON_LEFT | BUTTON_RIGHT:
+		break;
+	}
+	return 0;
+}
+
+// ui_review is the single screen used for every field of every transaction.
+// review_load_field swaps in the title and value before each display. The
+// value is last so that scrolling redraws only it.
+#define UI_REVIEW_TEXT_INDEX 4
+
+static const bagl_element_t ui_review[] = {
+	UI_BACKGROUND(),
+	UI_ICON_LEFT(0x01, BAGL_GLYPH_ICON_LEFT),
+	UI_ICON_RIGHT(0x02, BAGL_GLYPH_ICON_RIGHT),
+	UI_TEXT(0x00, 0, 12, 128, review.title),
+	UI_SCROLL_TEXT(0, 26, 128),
+};
+
+static const bagl_element_t* ui_prepro_review(const bagl_element_t *element) {
+	return ui_scroll_prepro(element);
+}
+
+static unsigned int ui_review_button(unsigned int button_mask, unsigned int button_mask_counter) {
+	if (ui_scroll_button(button_mask, button_mask_counter, UI_REVIEW_TEXT_INDEX)) {
+		return 0;
+	}
+	switch (button_mask) {
+	case BUTTON_EVT_RELEASED | BUTTON_LEFT | BUTTON_RIGHT: // PROCEED
+		if (review.index + 1 < review.count) {
+			review_load_field(review.index + 1);
+			ui_scroll_start(global.displayContext.fullStr, global.displayContext.fullStr_len);
+			UX_DISPLAY(ui_review, ui_prepro_review);
+		} else {
+			review_load_prompt();
+			UX_DISPLAY(ui_signTxn_approve, ui_prepro_signTxn_approve);
+		}
+		break;
+	}
+	return 0;
+}
+
+// ui_signTxn_approve_condensed is the approval screen of a condensed review,
+// which follows its summary. Pressing both buttons walks the fields instead.
+static const bagl_element_t ui_signTxn_approve_condensed[] = {
+	UI_BACKGROUND(),
+	UI_ICON_LEFT(0x00, BAGL_GLYPH_ICON_CROSS),
+	UI_ICON_RIGHT(0x00, BAGL_GLYPH_ICON_CHECK),
+
+	UI_TEXT(0x00, 0, 12, 128, review.title),
+	UI_TEXT(0x00, 0, 26, 128, "Both: details"),
+};
+
+static const bagl_element_t* ui_prepro_signTxn_approve_condensed(const bagl_element_t *element) {
+	return element;
+}
+
+static unsigned int ui_signTxn_approve_condensed_button(unsigned int button_mask, unsigned int button_mask_counter) {
+	switch (button_mask) {
+	case BUTTON_EVT_RELEASED | BUTTON_LEFT | BUTTON_RIGHT: // DETAILS
+		review.condensed = false;
+		review_load_field(0);
+		ui_scroll_start(global.displayContext.fullStr, global.displayContext.fullStr_len);
+		UX_DISPLAY(ui_review, ui_prepro_review);
+		return 0;
+	}
+	return ui_signTxn_approve_button(button_mask, button_mask_counter);
+}
+
+// ui_review_summary shows the summary of a condensed review like a field,
+// under a title of its own.
+static const bagl_element_t ui_review_summary[] = {
+	UI_BACKGROUND(),
+	UI_ICON_LEFT(0x01, BAGL_GLYPH_ICON_LEFT),
+	UI_ICON_RIGHT(0x02, BAGL_GLYPH_ICON_RIGHT),
+	UI_TEXT(0x00, 0, 12, 128, "Summary"),
+	UI_SCROLL_TEXT(0, 26, 128),
+};
+
+static unsigned int ui_review_summary_button(unsigned int button_mask, unsigned int button_mask_counter) {
+	if (ui_scroll_button(button_mask, button_mask_counter, UI_REVIEW_TEXT_INDEX)) {
+		return 0;
+	}
+	switch (button_mask) {
+	case BUTTON_EVT_RELEASED | BUTTON_LEFT | BUTTON_RIGHT: // PROCEED
+		review_load_prompt();
+		UX_DISPLAY(ui_signTxn_approve_condensed, ui_prepro_signTxn_approve_condensed);
+		break;
+	}
+	return 0;
+}
+
+void ui_review_display(void) {
+	if (review.condensed) {
+		ui_scroll_start(global.reviewSummaryContext.summary, global.reviewSummaryContext.summary_len);
+		UX_DISPLAY(ui_review_summary, ui_prepro_review);
+		return;
+	}
+	review_load_field(0);
+	ui_scroll_start(global.displayContext.fullStr, global.displayContext.fullStr_len);
+	UX_DISPLAY(ui_review, ui_prepro_review);
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include "bolos_target.h"
+
+#if defined(TARGET_NANOS) && !defined(HAVE_UX_FLOW)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "helium_ux.h"
+
+// Held buttons repeat as BUTTON_EVT_FAST events; every 8 repeats the window
+// moves one more character per event, up to UI_SCROLL_MAX_STEP.
+#define UI_SCROLL_MAX_STEP 4
+
+static struct {
+	uint8_t *text;
+	uint16_t len;
+	uint16_t index;
+} scroll;
+
+void ui_scroll_start(uint8_t *text, uint16_t len) {
+	scroll.text = text;
+	scroll.len = len;
+	scroll.index = 0;
+}
+
+static uint16_t ui_scroll_last_index(void) {
+	if (scroll.len <= UI_SCROLL_WINDOW) {
+		return 0;
+	}
+	return scroll.len - UI_SCROLL_WINDOW;
+}
+
+const bagl_element_t *ui_scroll_prepro(const bagl_element_t *element) {
+	if ((element->component.userid == 1 && scroll.index == 0) ||
+	    (element->component.userid == 2 && scroll.index >= ui_scroll_last_index())) {
+		return NULL;
+	}
+	return element;
+}
+
+bool ui_scroll_button(unsigned int button_mask, unsigned int button_mask_counter, uint8_t text_index) {
+	uint16_t last = ui_scroll_last_index();
+	uint16_t before = scroll.index;
+	uint8_t step = 1;
+
+	if (button_mask & BUTTON_EVT_FAST) {
+		step += button_mask_counter / 8;
+		if (step > UI_SCROLL_MAX_STEP) {
+			step = UI_SCROLL_MAX_STEP;
+		}
+	}
+
+	switch (button_mask) {
+	case BUTTON_LEFT:
+	case BUTTON_EVT_FAST | BUTTON_LEFT: // SEEK LEFT
+		scroll.index = (scroll.index > step) ? scroll.index - step : 0;
+		break;
+
+	case BUTTON_RIGHT:
+	case BUTTON_EVT_FAST | BUTTON_RIGHT: // SEEK RIGHT
+		scroll.index = (scroll.index + step < last) ? scroll.index + step : last;
+		break;
+
+	default:
+		return false;
+	}
+
+	if (scroll.index == before) {
+		return true;
+	}
+	// the arrows only change when the window reaches or leaves an end
+	if (before == 0 || before == last || scroll.index == 0 || scroll.index == last) {
+		UX_REDISPLAY();
+	} else {
+		UX_REDISPLAY_IDX(text_index);
+	}
+	return true;
+}
+
+void ui_scroll_display(const bagl_element_t *element) {
+	bagl_element_t window = *element;
+	uint16_t end = scroll.index + UI_SCROLL_WINDOW;
+	uint8_t saved = 0;
+
+	window.text = (const char *)scroll.text + scroll.index;
+	// terminate the window in place for the duration of the send
+	if (end < scroll.len) {
+		saved = scroll.text[end];
+		scroll.text[end] = '\0';
+	}
+	io_seproxyhal_display_default(&window);
+	if (end < scroll.len) {
+		scroll.text[end] = saved;
+	}
+}
+
+#endif
@@ -36,8 +36,8 @@ void ui_getPublicKey(void)
 // reads the command parameters, prepares and displays the approval screen,
 // and 
 void handle_get_public_key(uint8_t p1, uint8_t p2,
-                           __attribute__((unused)) uint8_t *dataBuffer,
-                           __attribute__((unused)) uint16_t dataLength,
+                           uint8_t *dataBuffer,
+                           uint16_t dataLength,
                            __attribute__((unused)) volatile unsigned int *flags,
                            __attribute__((unused)) volatile unsigned int *tx) {
 	size_t output_len;
@@ -45,6 +45,12 @@ void handle_get_public_key(uint8_t p1, uint8_t p2,
 	if ((p1 != P1_PUBKEY_DISPLAY_ON) && (p1 != P1_PUBKEY_DISPLAY_OFF)) {
 		THROW(SW_INVALID_PARAM);
 	}
+	// The account is P2, or the path follows the command (see
+	// save_account_path). It is read before the reply overwrites it.
+	accountPath_t path;
+	if (!save_account_path(p2, dataBuffer, dataLength, 0, &path)) {
+		THROW(SW_INVALID_PARAM);
+	}
 	uint16_t adpu_tx = 2;
 
 	G_io_apdu_buffer[0] = 0; // prepend 0 byte to signify b58 format
@@ -53,8 +59,7 @@ void handle_get_public_key(uint8_t p1, uint8_t p2,
 #else
 	G_io_apdu_buffer[1] = NETTYPE_MAIN | KEYTYPE_ED25519;
 #endif
-	uint8_t account = p2;
-	get_pubkey_bytes(account, &G_io_apdu_buffer[adpu_tx]);
+	get_pubkey_bytes(&path, &G_io_apdu_buffer[adpu_tx]);
 	adpu_tx += SIZE_OF_PUB_KEY_BIN;
 
 	cx_sha256_t hash;
@@ -2,7 +2,11 @@
 
 #ifdef HAVE_UX_FLOW
 
+#include <string.h>
 #include "ux.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "helium_settings.h"
 
 ux_state_t G_ux;
 bolos_ux_params_t G_ux_params;
@@ -36,6 +40,14 @@ UX_DEF(menu_about,
 
 ////////////////
 // MENU :
+static char expert_review_label[sizeof("Disabled")];
+
+static void menu_load_labels(void) {
+  strcpy(expert_review_label, settings_expert_review() ? "Enabled" : "Disabled");
+}
+
+static void menu_toggle_expert_review(void);
+
 UX_FLOW_DEF_NOCB(
   menu_main_waiting_commands_step,
   nn,
@@ -44,6 +56,15 @@ UX_FLOW_DEF_NOCB(
     "commands..."
   });
 
+UX_FLOW_DEF_VALID(
+  menu_main_expert_review_step,
+  bn,
+  menu_toggle_expert_review(),
+  {
+    "Expert review",
+    expert_review_label,
+  });
+
 UX_FLOW_DEF_VALID(
   menu_main_about_step,
   nnn,
@@ -66,13 +87,24 @@ UX_FLOW_DEF_VALID(
 
 UX_DEF(menu_main,
        &menu_main_waiting_commands_step,
+       &menu_main_expert_review_step,
        &menu_main_about_step,
        &menu_main_quit_step
        );
 
+// menu_toggle_expert_review switches between the summary and the full
+// fields as the first screen of transaction reviews.
+static void menu_toggle_expert_review(void) {
+  settings_set_expert_review(!settings_expert_review());
+  menu_load_labels();
+  ux_flow_init(0, menu_main, &menu_main_expert_review_step);
+}
+
 // ui_idle displays the main menu. Note that your app isn't required to use a
 // menu as its idle screen; you can define your own completely custom screen.
 void ui_idle(void) {
+    review_wipe();
+    menu_load_labels();
     if(G_ux.stack_count == 0) {
 	ux_stack_push();
       }
@@ -0,0 +1,158 @@
+#include "bolos_target.h"
+
+#ifdef HAVE_UX_FLOW
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "helium.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+
+// The review flow has a single bnnn_paging step that is reused for every
+// field. It is surrounded by two invisible delimiter steps: when the user
+// walks onto a delimiter, we load the neighbouring field and bounce back onto
+// the paging step, or let them through once the first or last field has been
+// passed.
+static bool review_inside_fields;
+
+static void review_upper_delimiter(void) {
+  if (!review_inside_fields) {
+    // coming forward from the intro screen
+    review_load_field(0);
+    review_inside_fields = true;
+    ux_flow_next();
+  } else if (review.index > 0) {
+    // walking back through the fields
+    review_load_field(review.index - 1);
+    ux_flow_next();
+  } else {
+    review_inside_fields = false;
+    ux_flow_prev();
+  }
+}
+
+static void review_lower_delimiter(void) {
+  if (!review_inside_fields) {
+    // coming back from the approval screen
+    review_load_field(review.count - 1);
+    review_inside_fields = true;
+    ux_flow_prev();
+  } else if (review.index + 1 < review.count) {
+    // walking forward through the fields
+    review_load_field(review.index + 1);
+    ux_flow_prev();
+  } else {
+    review_inside_fields = false;
+    review_load_prompt();
+    ux_flow_next();
+  }
+}
+
+UX_STEP_NOCB(
+    ux_review_intro,
+    nn,
+    {
+      "Review",
+      "transaction"
+    });
+
+UX_STEP_INIT(
+    ux_review_upper_delimiter,
+    NULL,
+    NULL,
+    {
+      review_upper_delimiter();
+    });
+
+UX_STEP_NOCB(
+    ux_review_field,
+    bnnn_paging,
+    {
+      .title = review.title,
+      .text = (char *)global.displayContext.fullStr
+    });
+
+UX_STEP_INIT(
+    ux_review_lower_delimiter,
+    NULL,
+    NULL,
+    {
+      review_lower_delimiter();
+    });
+
+UX_STEP_CB(
+    ux_review_sign_approve,
+    nn,
+    review_validate(true),
+    {
+      review.title,
+      "YES"
+    });
+
+UX_STEP_CB(
+    ux_review_sign_decline,
+    nn,
+    review_validate(false),
+    {
+      review.title,
+      "NO"
+    });
+
+UX_DEF(ux_review_flow,
+       &ux_review_intro,
+       &ux_review_upper_delimiter,
+       &ux_review_field,
+       &ux_review_lower_delimiter,
+       &ux_review_sign_approve,
+       &ux_review_sign_decline
+);
+
+// A condensed review puts its summary right before the approval, and the full
+// review flow one step after it.
+static void review_show_details(void) {
+  review_inside_fields = false;
+  ux_flow_init(0, ux_review_flow, NULL);
+}
+
+UX_STEP_NOCB(
+    ux_review_summary,
+    bnnn_paging,
+    {
+      .title = "Summary",
+      .text = (char *)global.reviewSummaryContext.summary
+    });
+
+UX_STEP_CB(
+    ux_review_details,
+    nn,
+    review_show_details(),
+    {
+      "Show",
+      "details"
+    });
+
+UX_DEF(ux_review_summary_flow,
+       &ux_review_summary,
+       &ux_review_sign_approve,
+       &ux_review_sign_decline,
+       &ux_review_details
+);
+
+void ui_review_display(void) {
+  review_inside_fields = false;
+
+  if(G_ux.stack_count == 0) {
+    ux_stack_push();
+  }
+  if (review.condensed) {
+    review_load_prompt();
+    ux_flow_init(0, ux_review_summary_flow, NULL);
+  } else {
+    ux_flow_init(0, ux_review_flow, NULL);
+  }
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <os.h>
+#include <os_io_seproxyhal.h>
+#include "txns/helium.h"
+#include "ux/helium_ux.h"
+#include "key_set.h"
+
+// The verifyAddresses command checks which of a list of addresses belong to
+// a range of accounts on this device, without displaying anything:
+//
+//   P1_VERIFY_FIRST_KEYS  starts a new list with up to
+//                         VERIFY_KEYS_PER_APDU 33-byte keys.
+//   P1_VERIFY_MORE_KEYS   appends as many more. Either replies with the
+//                         number of keys in the list (1 byte).
+//   P1_VERIFY_SEARCH      derives the keys of accounts 'first' to
+//                         'first' + 'count' - 1, at 44'/904'/account'/0'/0',
+//                         and matches each one against the list. The
+//                         payload is 'first' (4 bytes, little-endian) and
+//                         'count' (1 byte, at most VERIFY_SEARCH_MAX).
+//
+// The reply to a search is a bitmap of the keys found so far, in any search
+// since the list was started: bit i % 8 of byte i / 8 is key i of the list.
+// Searching a large range takes several commands, which keeps each of them
+// short. The list lives in the command context, so any other command ends
+// the run.
+
+#define CTX global.verifyAddressesContext
+
+static bool verify_started;
+
+void verify_reset(void) {
+	verify_started = false;
+}
+
+static void verify_add_keys(uint8_t *dataBuffer, uint16_t dataLength) {
+	uint8_t count = dataLength / KEY_SET_KEY_LEN;
+	if (count == 0 || count > VERIFY_KEYS_PER_APDU || dataLength != count * KEY_SET_KEY_LEN) {
+		THROW(SW_INVALID_PARAM);
+	}
+	if (count > KEY_SET_CAPACITY - CTX.keys.count) {
+		THROW(SW_INVALID_PARAM);
+	}
+	for (uint8_t i = 0; i < count; i++) {
+		key_set_add(&CTX.keys, &dataBuffer[i * KEY_SET_KEY_LEN]);
+	}
+	G_io_apdu_buffer[0] = CTX.keys.count;
+	io_exchange_with_code(SW_OK, 1);
+}
+
+static void verify_search(uint8_t *dataBuffer, uint16_t dataLength) {
+	if (!verify_started) {
+		THROW(SW_IMPROPER_INIT);
+	}
+	if (dataLength != 5) {
+		THROW(SW_INVALID_PARAM);
+	}
+	uint32_t first = dataBuffer[0] | (dataBuffer[1] << 8) | (dataBuffer[2] << 16) | ((uint32_t)dataBuffer[3] << 24);
+	uint8_t count = dataBuffer[4];
+	if (count == 0 || count > VERIFY_SEARCH_MAX || first > ACCOUNT_INDEX_MAX - (uint32_t)(count - 1)) {
+		THROW(SW_INVALID_PARAM);
+	}
+
+	accountPath_t path = {first, 0, 0};
+	uint8_t key[KEY_SET_KEY_LEN];
+#ifdef HELIUM_TESTNET
+	key[0] = NETTYPE_TEST | KEYTYPE_ED25519;
+#else
+	key[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+#endif
+	for (uint8_t i = 0; i < count; i++, path.account++) {
+		get_pubkey_bytes(&path, &key[1]);
+		key_set_match(&CTX.keys, key);
+	}
+
+	memmove(G_io_apdu_buffer, CTX.keys.found, sizeof(CTX.keys.found));
+	io_exchange_with_code(SW_OK, sizeof(CTX.keys.found));
+}
+
+// handle_verify_addresses is the entry point for the verifyAddresses command,
+// which P1 steps through as described above.
+void handle_verify_addresses(uint8_t p1, uint8_t p2, uint8_t *dataBuffer, uint16_t dataLength, volatile unsigned int *flags, volatile unsigned int *tx) {
+	UNUSED(p2); UNUSED(flags); UNUSED(tx);
+	switch (p1) {
+	case P1_VERIFY_FIRST_KEYS:
+		key_set_reset(&CTX.keys);
+		verify_started = true;
+		verify_add_keys(dataBuffer, dataLength);
+		break;
+	case P1_VERIFY_MORE_KEYS:
+		if (!verify_started) {
+			THROW(SW_IMPROPER_INIT);
+		}
+		verify_add_keys(dataBuffer, dataLength);
+		break;
+	case P1_VERIFY_SEARCH:
+		verify_search(dataBuffer, dataLength);
+		break;
+	default:
+		THROW(SW_INVALID_PARAM);
+	}
+}
@@ -0,0 +1,307 @@
+//! End-to-end benchmark of the app running in Speculos.
+//!
+//! The bench launches Speculos, sends N requests of each instruction and
+//! approves every review through the Speculos REST API, pressing the same
+//! buttons a user would. It reports per-INS latency percentiles, signatures
+//! per second and the number of button presses each review took, as JSON.
+//!
+//!     cargo run --bin bench -- --elf ../../bin/app.elf --model nanos -n 50
+use helium_crypto::PublicKey;
+use helium_ledger::txns::*;
+use serde_json::json;
+use std::path::PathBuf;
+use std::str::FromStr;
+use std::sync::mpsc;
+use std::thread;
+use std::time::{Duration, Instant};
+
+mod speculos;
+use speculos::*;
+
+type Result<T = ()> = std::result::Result<T, Error>;
+
+const APDU_PORT: u16 = 9999;
+const API_PORT: u16 = 5000;
+const SW_OK: u16 = 0x9000;
+const PAYEE: &str = "145kQhY9Asu5ZxCpd1zifSkr2VYhDLWXQqgpQhgs8TEwA6SWWLa";
+const OTHER: &str = "14sf44Spo6t7Qs6FNhBttitR16n9ZJXppPgj1NoQPfD55vRK4i3";
+const VALIDATOR: &str = "11YzguYUdqCzonqrqCSMEcZPA2YGNdu9JQBQMbkwcErvUrixy4R";
+const OTHER_VALIDATOR: &str = "11u76hY8bzrbo7AdJ68qEkXDGPNP3CpUdt42Lgar9YSJ99KyYNS";
+
+struct Options {
+    speculos: PathBuf,
+    elf: PathBuf,
+    model: String,
+    count: usize,
+    output: Option<PathBuf>,
+}
+
+fn main() -> Result {
+    let options = parse_args()?;
+    let speculos = Speculos::launch(&options.speculos, &options.elf, &options.model, APDU_PORT, API_PORT)?;
+    let mut transport = speculos.connect()?;
+
+    let version = transport_exchange(&mut transport, &get_version())?;
+    let mut results = Vec::new();
+    for (name, build) in workloads() {
+        let mut latencies = Vec::with_capacity(options.count);
+        let mut presses = 0;
+        let mut ins = 0;
+        let started = Instant::now();
+        for i in 0..options.count {
+            let command = build(i as u64 + 1)?;
+            ins = command.ins;
+            let (latency, pressed) = exchange_approving(&speculos, &mut transport, &command, &options.model)?;
+            latencies.push(latency);
+            presses += pressed;
+        }
+        let elapsed = started.elapsed().as_secs_f64();
+        latencies.sort();
+        results.push(json!({
+            "name": name,
+            "ins": format!("0x{ins:02X}"),
+            "count": options.count,
+            "p50_ms": percentile(&latencies, 50.0),
+            "p99_ms": percentile(&latencies, 99.0),
+            "per_second": options.count as f64 / elapsed,
+            "button_presses": presses as f64 / options.count as f64,
+        }));
+    }
+
+    let report = json!({
+        "app_version": version.data.iter().map(u8::to_string).collect::<Vec<_>>().join("."),
+        "model": options.model,
+        "results": results,
+    });
+    let report = serde_json::to_string_pretty(&report)?;
+    match options.output {
+        Some(path) => std::fs::write(path, report)?,
+        None => println!("{report}"),
+    }
+    Ok(())
+}
+
+fn parse_args() -> Result<Options> {
+    let mut options = Options {
+        speculos: PathBuf::from("speculos.py"),
+        elf: PathBuf::from("../../bin/app.elf"),
+        model: "nanos".to_string(),
+        count: 20,
+        output: None,
+    };
+    let mut args = std::env::args().skip(1);
+    while let Some(arg) = args.next() {
+        let value = args.next().ok_or(Error::Usage(arg.clone()))?;
+        match arg.as_str() {
+            "--speculos" => options.speculos = PathBuf::from(value),
+            "--elf" => options.elf = PathBuf::from(value),
+            "--model" => options.model = value,
+            "-n" | "--count" => options.count = value.parse().map_err(|_| Error::Usage(arg))?,
+            "-o" | "--output" => options.output = Some(PathBuf::from(value)),
+            _ => return Err(Error::Usage(arg)),
+        }
+    }
+    Ok(options)
+}
+
+type Workload = fn(u64) -> Result<APDUCommand>;
+
+/// Every signing instruction, plus the silent public key query, which
+/// measures key derivation on its own. The argument varies the nonce or
+/// amount so no two requests are identical.
+fn workloads() -> Vec<(&'static str, Workload)> {
+    vec![
+        ("get_public_key", get_public_key as Workload),
+        ("payment_v2", payment_v2 as Workload),
+        ("token_burn_v1", token_burn_v1 as Workload),
+        ("security_exchange_v1", security_exchange_v1 as Workload),
+        ("stake_validator_v1", stake_validator_v1 as Workload),
+        ("unstake_validator_v1", unstake_validator_v1 as Workload),
+        ("transfer_validator_stake_v1", transfer_validator_stake_v1 as Workload),
+    ]
+}
+
+fn get_public_key(i: u64) -> Result<APDUCommand> {
+    Ok(APDUCommand {
+        cla: 0xE0,
+        ins: 0x02,
+        p1: 0x00,
+        p2: (i % 256) as u8,
+        data: vec![],
+    })
+}
+
+fn payment_v2(i: u64) -> Result<APDUCommand> {
+    let payment = BlockchainTxnPaymentV2 {
+        payer: vec![],
+        payments: vec![Payment {
+            payee: key(PAYEE)?.to_vec(),
+            amount: 100_000_000 + i,
+            memo: i,
+        }],
+        nonce: i,
+        fee: 35000,
+        signature: vec![],
+    };
+    Ok(payment.apdu_serialize(0)?)
+}
+
+fn token_burn_v1(i: u64) -> Result<APDUCommand> {
+    let burn = BlockchainTxnTokenBurnV1 {
+        payer: vec![],
+        payee: key(PAYEE)?.to_vec(),
+        amount: 100_000_000 + i,
+        memo: i,
+        nonce: i,
+        fee: 35000,
+        signature: vec![],
+    };
+    Ok(burn.apdu_serialize(0)?)
+}
+
+fn security_exchange_v1(i: u64) -> Result<APDUCommand> {
+    let transfer_sec = BlockchainTxnSecurityExchangeV1 {
+        payer: vec![],
+        payee: key(PAYEE)?.to_vec(),
+        amount: 100_000_000 + i,
+        nonce: i,
+        fee: 35000,
+        signature: vec![],
+    };
+    Ok(transfer_sec.apdu_serialize(0)?)
+}
+
+fn stake_validator_v1(i: u64) -> Result<APDUCommand> {
+    let stake = BlockchainTxnStakeValidatorV1 {
+        owner: vec![],
+        address: key(VALIDATOR)?.to_vec(),
+        stake: 1_000_000_000_000 + i,
+        fee: 35000,
+        owner_signature: vec![],
+    };
+    Ok(stake.apdu_serialize(0)?)
+}
+
+fn unstake_validator_v1(i: u64) -> Result<APDUCommand> {
+    let unstake = BlockchainTxnUnstakeValidatorV1 {
+        owner: vec![],
+        address: key(VALIDATOR)?.to_vec(),
+        stake_amount: 1_000_000_000_000,
+        stake_release_height: 1_000_000 + i,
+        fee: 35000,
+        owner_signature: vec![],
+    };
+    Ok(unstake.apdu_serialize(0)?)
+}
+
+fn transfer_validator_stake_v1(i: u64) -> Result<APDUCommand> {
+    let transfer = BlockchainTxnTransferValidatorStakeV1 {
+        old_owner: key(PAYEE)?.to_vec(),
+        new_owner: key(OTHER)?.to_vec(),
+        old_address: key(VALIDATOR)?.to_vec(),
+        new_address: key(OTHER_VALIDATOR)?.to_vec(),
+        stake_amount: 1_000_000_000_000,
+        payment_amount: i,
+        fee: 35000,
+        old_owner_signature: vec![],
+        new_owner_signature: vec![],
+    };
+    Ok(transfer.apdu_serialize(0)?)
+}
+
+fn key(b58: &str) -> Result<PublicKey> {
+    Ok(PublicKey::from_str(b58)?)
+}
+
+fn get_version() -> APDUCommand {
+    APDUCommand {
+        cla: 0xE0,
+        ins: 0x01,
+        p1: 0x00,
+        p2: 0x00,
+        data: vec![],
+    }
+}
+
+fn transport_exchange(transport: &mut ApduTransport, command: &APDUCommand) -> Result<Reply> {
+    transport.send(command)?;
+    let reply = transport.receive()?;
+    if reply.sw != SW_OK {
+        return Err(Error::Status(command.ins, reply.sw));
+    }
+    Ok(reply)
+}
+
+/// Sends 'command' and approves the review it starts, if any. Returns the
+/// time until the reply arrived and the number of buttons pressed.
+fn exchange_approving(
+    speculos: &Speculos,
+    transport: &mut ApduTransport,
+    command: &APDUCommand,
+    model: &str,
+) -> Result<(Duration, usize)> {
+    let mut receiver = transport.try_clone()?;
+    let (tx, rx) = mpsc::channel();
+    let started = Instant::now();
+    transport.send(command)?;
+    thread::spawn(move || {
+        let _ = tx.send(receiver.receive().map(|reply| (reply, started.elapsed())));
+    });
+
+    let mut presses = 0;
+    let mut last_screen = Vec::new();
+    loop {
+        match rx.recv_timeout(Duration::from_millis(20)) {
+            Ok(result) => {
+                let (reply, latency) = result?;
+                if reply.sw != SW_OK {
+                    return Err(Error::Status(command.ins, reply.sw));
+                }
+                return Ok((latency, presses));
+            }
+            Err(mpsc::RecvTimeoutError::Timeout) => (),
+            Err(mpsc::RecvTimeoutError::Disconnected) => return Err(Error::Timeout("reply thread died")),
+        }
+        if started.elapsed() > Duration::from_secs(120) {
+            return Err(Error::Timeout("no reply from the app"));
+        }
+        let screen = speculos.screen()?;
+        // wait for each press to be rendered before pressing again
+        if screen.is_empty() || screen == last_screen || is_idle(&screen) {
+            continue;
+        }
+        speculos.press(next_button(&screen, model))?;
+        presses += 1;
+        last_screen = screen;
+    }
+}
+
+fn percentile(sorted: &[Duration], p: f64) -> f64 {
+    if sorted.is_empty() {
+        return 0.0;
+    }
+    let rank = ((p / 100.0) * (sorted.len() - 1) as f64).round() as usize;
+    sorted[rank].as_secs_f64() * 1000.0
+}
+
+use thiserror::Error;
+
+#[derive(Error, Debug)]
+pub enum Error {
+    #[error("Helium Crypto error: {0}")]
+    Crypto(#[from] helium_crypto::error::Error),
+    #[error("Helium Ledger error: {0}")]
+    HeliumLedger(#[from] helium_ledger::Error),
+    #[error("IO error: {0}")]
+    Io(#[from] std::io::Error),
+    #[error("Speculos API error: {0}")]
+    Api(#[from] Box<ureq::Error>),
+    #[error("JSON error: {0}")]
+    Json(#[from] serde_json::Error),
+    #[error("INS 0x{0:02X} failed with status 0x{1:04X}")]
+    Status(u8, u16),
+    #[error("timeout: {0}")]
+    Timeout(&'static str),
+    #[error("bad argument: {0}")]
+    Usage(String),
+}
@@ -0,0 +1,130 @@
+use std::path::Path;
+
+use super::{Error, Result};
+
+/// A function of the app, from the symbol table of its ELF.
+pub struct Function {
+    pub name: String,
+    pub start: u32,
+    pub end: u32,
+}
+
+/// The functions of the app, sorted by address, and the range of its code.
+/// Speculos loads the app at the addresses it is linked at, so the program
+/// counters of the emulator map to them directly.
+pub struct Symbols {
+    functions: Vec<Function>,
+    code_start: u32,
+    code_end: u32,
+}
+
+const SHT_SYMTAB: u32 = 2;
+const SHF_EXECINSTR: u32 = 0x4;
+const STT_FUNC: u8 = 2;
+
+fn u16_at(bytes: &[u8], offset: usize) -> Result<u16> {
+    bytes
+        .get(offset..offset + 2)
+        .map(|b| u16::from_le_bytes([b[0], b[1]]))
+        .ok_or(Error::Elf("truncated"))
+}
+
+fn u32_at(bytes: &[u8], offset: usize) -> Result<u32> {
+    bytes
+        .get(offset..offset + 4)
+        .map(|b| u32::from_le_bytes([b[0], b[1], b[2], b[3]]))
+        .ok_or(Error::Elf("truncated"))
+}
+
+impl Symbols {
+    /// Reads the function symbols of a 32-bit little-endian ELF. The app
+    /// must be built with its symbols, as the Makefile does.
+    pub fn load(path: &Path) -> Result<Symbols> {
+        let elf = std::fs::read(path)?;
+        if !elf.starts_with(b"\x7fELF") || elf.get(4) != Some(&1) || elf.get(5) != Some(&1) {
+            return Err(Error::Elf("not a 32-bit little-endian ELF"));
+        }
+        let shoff = u32_at(&elf, 0x20)? as usize;
+        let shentsize = u16_at(&elf, 0x2E)? as usize;
+        let shnum = u16_at(&elf, 0x30)? as usize;
+        let section = |i: usize, field: usize| u32_at(&elf, shoff + i * shentsize + field);
+
+        let mut code_start = u32::MAX;
+        let mut code_end = 0;
+        let mut symtab = None;
+        for i in 0..shnum {
+            if section(i, 8)? & SHF_EXECINSTR != 0 {
+                let addr = section(i, 12)?;
+                code_start = code_start.min(addr);
+                code_end = code_end.max(addr + section(i, 20)?);
+            }
+            if section(i, 4)? == SHT_SYMTAB {
+                symtab = Some(i);
+            }
+        }
+        let symtab = symtab.ok_or(Error::Elf("no symbol table"))?;
+        let strtab = section(symtab, 24)? as usize;
+        let strings = section(strtab, 16)? as usize;
+        let offset = section(symtab, 16)? as usize;
+        let count = section(symtab, 20)? as usize / 16;
+
+        let mut functions = Vec::new();
+        for i in 0..count {
+            let entry = offset + i * 16;
+            let info = *elf.get(entry + 12).ok_or(Error::Elf("truncated"))?;
+            if info & 0xF != STT_FUNC {
+                continue;
+            }
+            let name_at = strings + u32_at(&elf, entry)? as usize;
+            let name = elf
+                .get(name_at..)
+                .and_then(|s| s.split(|&b| b == 0).next())
+                .ok_or(Error::Elf("bad symbol name"))?;
+            // the low bit of a Thumb function is not part of its address
+            let start = u32_at(&elf, entry + 4)? & !1;
+            functions.push(Function {
+                name: String::from_utf8_lossy(name).into_owned(),
+                start,
+                end: start + u32_at(&elf, entry + 8)?,
+            });
+        }
+        functions.sort_by_key(|f| f.start);
+        functions.dedup_by_key(|f| f.start);
+        // a function without a size ends where the next one starts
+        for i in 0..functions.len() {
+            if functions[i].end == functions[i].start {
+                functions[i].end = functions.get(i + 1).map_or(code_end, |next| next.start);
+            }
+        }
+        if functions.is_empty() {
+            return Err(Error::Elf("no function symbols"));
+        }
+        Ok(Symbols {
+            functions,
+            code_start,
+            code_end,
+        })
+    }
+
+    /// Returns whether 'pc' is in the code of the app rather than in Speculos.
+    pub fn is_app(&self, pc: u32) -> bool {
+        pc >= self.code_start && pc < self.code_end
+    }
+
+    /// Returns the index of the function 'pc' is in.
+    pub fn lookup(&self, pc: u32) -> Option<usize> {
+        let i = self.functions.partition_point(|f| f.start <= pc);
+        if i == 0 || pc >= self.functions[i - 1].end {
+            return None;
+        }
+        Some(i - 1)
+    }
+
+    pub fn find(&self, name: &str) -> Option<&Function> {
+        self.functions.iter().find(|f| f.name == name)
+    }
+
+    pub fn function(&self, index: usize) -> &Function {
+        &self.functions[index]
+    }
+}
@@ -0,0 +1,170 @@
+use std::io::{ErrorKind, Read, Write};
+use std::net::TcpStream;
+use std::thread;
+use std::time::{Duration, Instant};
+
+use super::{Error, Result};
+
+/// A client of the gdb remote protocol, for the stub QEMU serves when
+/// Speculos runs with --debug. Only what the profiler needs is implemented:
+/// stepping, continuing, interrupting, reading the registers and software
+/// breakpoints.
+pub struct Gdb {
+    stream: TcpStream,
+    buffer: Vec<u8>,
+    acks: bool,
+    // a signal the target stopped on, to deliver when it resumes
+    signal: Option<u8>,
+}
+
+const SIGINT: u8 = 2;
+const SIGTRAP: u8 = 5;
+
+/// The ARM registers the profiler follows.
+pub struct Registers {
+    pub lr: u32,
+    pub pc: u32,
+}
+
+impl Gdb {
+    /// Connects to the stub on 'port', which QEMU opens once it has loaded
+    /// the app, and leaves the target stopped.
+    pub fn connect(port: u16, timeout: Duration) -> Result<Gdb> {
+        let start = Instant::now();
+        let stream = loop {
+            match TcpStream::connect(("127.0.0.1", port)) {
+                Ok(stream) => break stream,
+                Err(_) if start.elapsed() < timeout => thread::sleep(Duration::from_millis(200)),
+                Err(_) => return Err(Error::Timeout("no gdb stub")),
+            }
+        };
+        stream.set_nodelay(true)?;
+        let mut gdb = Gdb {
+            stream,
+            buffer: Vec::new(),
+            acks: true,
+            signal: None,
+        };
+        // every step is a round trip, so skip the acknowledgements if the
+        // stub lets us
+        if gdb.command("QStartNoAckMode")? == "OK" {
+            gdb.acks = false;
+        }
+        gdb.command("?")?;
+        Ok(gdb)
+    }
+
+    fn send(&mut self, packet: &str) -> Result {
+        let checksum = packet.bytes().fold(0u8, |sum, b| sum.wrapping_add(b));
+        self.stream.write_all(format!("${packet}#{checksum:02x}").as_bytes())?;
+        Ok(())
+    }
+
+    /// Reads the next packet, waiting at most 'wait' if given. The
+    /// acknowledgements of our own packets are skipped.
+    fn receive(&mut self, wait: Option<Duration>) -> Result<Option<String>> {
+        self.stream.set_read_timeout(wait)?;
+        loop {
+            if let Some(start) = self.buffer.iter().position(|&b| b == b'$') {
+                if let Some(end) = self.buffer[start..].iter().position(|&b| b == b'#') {
+                    let end = start + end;
+                    if self.buffer.len() >= end + 3 {
+                        let packet = String::from_utf8_lossy(&self.buffer[start + 1..end]).into_owned();
+                        self.buffer.drain(..end + 3);
+                        if self.acks {
+                            self.stream.write_all(b"+")?;
+                        }
+                        return Ok(Some(packet));
+                    }
+                }
+            }
+            let mut chunk = [0u8; 4096];
+            match self.stream.read(&mut chunk) {
+                Ok(0) => return Err(Error::Gdb("connection closed".to_string())),
+                Ok(n) => self.buffer.extend_from_slice(&chunk[..n]),
+                Err(e) if matches!(e.kind(), ErrorKind::WouldBlock | ErrorKind::TimedOut) => return Ok(None),
+                Err(e) => return Err(e.into()),
+            }
+        }
+    }
+
+    fn command(&mut self, packet: &str) -> Result<String> {
+        self.send(packet)?;
+        self.receive(None)?.ok_or(Error::Gdb(format!("no reply to {packet}")))
+    }
+
+    fn expect_ok(&mut self, packet: &str) -> Result {
+        match self.command(packet)?.as_str() {
+            "OK" => Ok(()),
+            reply => Err(Error::Gdb(format!("{packet}: {reply}"))),
+        }
+    }
+
+    /// Executes one instruction. The stop is read with wait_stop.
+    pub fn step(&mut self) -> Result {
+        match self.signal.take() {
+            Some(signal) => self.send(&format!("S{signal:02x}")),
+            None => self.send("s"),
+        }
+    }
+
+    /// Lets the target run until a breakpoint or an interrupt.
+    pub fn resume(&mut self) -> Result {
+        match self.signal.take() {
+            Some(signal) => self.send(&format!("C{signal:02x}")),
+            None => self.send("c"),
+        }
+    }
+
+    /// Waits at most 'wait' for the target to stop, and returns whether it
+    /// did. QEMU reports the signals of the app before delivering them, as
+    /// Speculos uses them to emulate the SDK calls: all but the traps of
+    /// stepping and breakpoints, and our interrupts, are passed on when the
+    /// target resumes.
+    pub fn wait_stop(&mut self, wait: Duration) -> Result<bool> {
+        match self.receive(Some(wait))? {
+            None => Ok(false),
+            Some(packet) if packet.starts_with('T') || packet.starts_with('S') => {
+                let signal = packet.get(1..3).and_then(|hex| u8::from_str_radix(hex, 16).ok());
+                self.signal = signal.filter(|&signal| signal != SIGINT && signal != SIGTRAP);
+                Ok(true)
+            }
+            Some(packet) if packet.starts_with('W') || packet.starts_with('X') => {
+                Err(Error::Gdb("the app exited".to_string()))
+            }
+            Some(packet) => Err(Error::Gdb(format!("unexpected stop reply {packet}"))),
+        }
+    }
+
+    /// Stops a running target. A target that stopped in the meantime sends
+    /// no second stop reply, so the wait is bounded.
+    pub fn interrupt(&mut self) -> Result {
+        self.stream.write_all(&[0x03])?;
+        self.wait_stop(Duration::from_secs(1))?;
+        Ok(())
+    }
+
+    pub fn registers(&mut self) -> Result<Registers> {
+        let reply = self.command("g")?;
+        // r0 to r15, each as the hex of its little-endian bytes
+        let register = |n: usize| -> Result<u32> {
+            let hex = reply
+                .get(n * 8..n * 8 + 8)
+                .ok_or(Error::Gdb(format!("short register reply {reply}")))?;
+            let value = u32::from_str_radix(hex, 16).map_err(|_| Error::Gdb(format!("bad register reply {reply}")))?;
+            Ok(value.swap_bytes())
+        };
+        Ok(Registers {
+            lr: register(14)?,
+            pc: register(15)?,
+        })
+    }
+
+    pub fn insert_breakpoint(&mut self, address: u32) -> Result {
+        self.expect_ok(&format!("Z0,{address:x},2"))
+    }
+
+    pub fn remove_breakpoint(&mut self, address: u32) -> Result {
+        self.expect_ok(&format!("z0,{address:x},2"))
+    }
+}
@@ -0,0 +1,529 @@
+//! Instruction-count profiler of the app running in Speculos.
+//!
+//! The profiler replays a trace recorded with the native runner (see
+//! tests/README.md) into Speculos, with QEMU under its gdb stub. During each
+//! exchange it steps the app one instruction at a time, from the command
+//! arriving to the app's next call to io_exchange, and charges every
+//! instruction to the call stack it runs in, rebuilt from the function
+//! symbols of the ELF. That call sends the reply, or, for a command with a
+//! review, waits for the user, and the review is approved as the bench does.
+//! While it is on screen, only the signing and the approval are charged:
+//! what runs under review_presign, on a ticker event, and under
+//! review_validate, until it calls io_exchange to send the reply. The
+//! ticker events, button handling and redraws around them depend on how
+//! long the review takes, so they are not. It writes the stacks folded for
+//! flamegraph.pl or inferno, one root per INS, and prints the instructions
+//! each INS took; --budget fails the run if an INS takes more than its
+//! budget.
+//!
+//!     cargo run --release --bin profile -- --elf ../../bin/app.elf \
+//!         --trace session.trace --folded app.folded --budget budget.json
+//!
+//! SDK calls leave the app for code Speculos emulates, which does not cost
+//! what the secure element does: by default they run at full speed and
+//! count as the one instruction that made them. --step-sdk steps through
+//! them too, under an "[sdk]" frame, which is much slower.
+use helium_ledger::txns::APDUCommand;
+use serde_json::{json, Map, Value};
+use std::collections::{BTreeMap, HashMap};
+use std::path::PathBuf;
+use std::sync::mpsc;
+use std::thread;
+use std::time::{Duration, Instant};
+
+mod elf;
+mod gdb;
+#[allow(dead_code)]
+mod speculos;
+mod trace;
+use elf::Symbols;
+use gdb::Gdb;
+use speculos::*;
+
+type Result<T = ()> = std::result::Result<T, Error>;
+
+const APDU_PORT: u16 = 9999;
+const API_PORT: u16 = 5000;
+const GDB_PORT: u16 = 1234;
+// the stack frame charged with the instructions Speculos runs for the app
+const SDK: usize = usize::MAX;
+// the functions charged to a command while its review is on screen
+const REVIEW_WORK: [&str; 2] = ["review_presign", "review_validate"];
+
+struct Options {
+    speculos: PathBuf,
+    elf: PathBuf,
+    model: String,
+    trace: PathBuf,
+    folded: Option<PathBuf>,
+    budget: Option<PathBuf>,
+    write_budget: Option<PathBuf>,
+    tolerance: f64,
+    step_sdk: bool,
+}
+
+fn main() -> Result {
+    let options = parse_args()?;
+    let symbols = Symbols::load(&options.elf)?;
+    let exchanges = trace::read(&options.trace)?;
+    let speculos = Speculos::spawn(
+        &options.speculos,
+        &options.elf,
+        &options.model,
+        APDU_PORT,
+        API_PORT,
+        &["--debug"],
+    )?;
+    let gdb = Gdb::connect(GDB_PORT, Duration::from_secs(30))?;
+    let mut profiler = Profiler::new(&symbols, gdb, options.step_sdk);
+    profiler.start()?;
+    speculos.wait_ready(Duration::from_secs(30))?;
+    let mut transport = speculos.connect()?;
+
+    let mut stats: BTreeMap<u8, InsStats> = BTreeMap::new();
+    let mut folded: HashMap<String, u64> = HashMap::new();
+    let mut differ = 0;
+    for (i, exchange) in exchanges.iter().enumerate() {
+        let ins = exchange.command.get(1).copied().unwrap_or(0);
+        let (reply, profile) = profiler.exchange(&speculos, &mut transport, &exchange.command, &options.model)?;
+        if reply != exchange.reply {
+            differ += 1;
+        }
+        let instructions: u64 = profile.stacks.values().sum();
+        eprintln!("exchange {i} (INS 0x{ins:02x}): {instructions} instructions");
+        let entry = stats.entry(ins).or_default();
+        entry.count += 1;
+        entry.instructions += instructions;
+        entry.max = entry.max.max(instructions);
+        entry.sdk_calls += profile.sdk_calls;
+        for (stack, count) in profile.stacks {
+            *folded.entry(profiler.fold(ins, &stack)).or_default() += count;
+        }
+    }
+
+    if let Some(path) = &options.folded {
+        let mut lines: Vec<String> = folded.iter().map(|(stack, count)| format!("{stack} {count}")).collect();
+        lines.sort();
+        std::fs::write(path, lines.join("\n") + "\n")?;
+    }
+    let budget = match &options.budget {
+        Some(path) => serde_json::from_str(&std::fs::read_to_string(path)?)?,
+        None => Value::Null,
+    };
+    let over = report(&stats, &budget, options.tolerance);
+    println!(
+        "{} exchanges profiled, {differ} replies differ from the trace",
+        exchanges.len()
+    );
+    if let Some(path) = &options.write_budget {
+        let budget: Map<String, Value> = stats
+            .iter()
+            .map(|(ins, stats)| (format!("0x{ins:02x}"), json!(stats.max)))
+            .collect();
+        std::fs::write(path, serde_json::to_string_pretty(&budget)?)?;
+    }
+    if over > 0 {
+        return Err(Error::Budget(over));
+    }
+    Ok(())
+}
+
+fn parse_args() -> Result<Options> {
+    let mut options = Options {
+        speculos: PathBuf::from("speculos.py"),
+        elf: PathBuf::from("../../bin/app.elf"),
+        model: "nanos".to_string(),
+        trace: PathBuf::new(),
+        folded: None,
+        budget: None,
+        write_budget: None,
+        tolerance: 1.0,
+        step_sdk: false,
+    };
+    let mut args = std::env::args().skip(1);
+    while let Some(arg) = args.next() {
+        if arg == "--step-sdk" {
+            options.step_sdk = true;
+            continue;
+        }
+        let value = args.next().ok_or(Error::Usage(arg.clone()))?;
+        match arg.as_str() {
+            "--speculos" => options.speculos = PathBuf::from(value),
+            "--elf" => options.elf = PathBuf::from(value),
+            "--model" => options.model = value,
+            "--trace" => options.trace = PathBuf::from(value),
+            "--folded" => options.folded = Some(PathBuf::from(value)),
+            "--budget" => options.budget = Some(PathBuf::from(value)),
+            "--write-budget" => options.write_budget = Some(PathBuf::from(value)),
+            "--tolerance" => options.tolerance = value.parse().map_err(|_| Error::Usage(arg))?,
+            _ => return Err(Error::Usage(arg)),
+        }
+    }
+    if options.trace.as_os_str().is_empty() {
+        return Err(Error::Usage("--trace is required".to_string()));
+    }
+    Ok(options)
+}
+
+#[derive(Default)]
+struct InsStats {
+    count: u64,
+    instructions: u64,
+    max: u64,
+    sdk_calls: u64,
+}
+
+/// Prints the instructions per INS, with the budget of each, and returns
+/// the number of INS whose most expensive exchange is over budget by more
+/// than 'tolerance' percent.
+fn report(stats: &BTreeMap<u8, InsStats>, budget: &Value, tolerance: f64) -> usize {
+    let mut over = 0;
+    println!(
+        "{:<6}{:>8}{:>16}{:>16}{:>12}{:>16}",
+        "INS", "count", "mean instr", "max instr", "sdk calls", "budget"
+    );
+    for (ins, stats) in stats {
+        let key = format!("0x{ins:02x}");
+        let limit = budget[&key].as_u64();
+        let verdict = match limit {
+            Some(limit) if stats.max as f64 > limit as f64 * (1.0 + tolerance / 100.0) => {
+                over += 1;
+                "  OVER"
+            }
+            _ => "",
+        };
+        println!(
+            "{key:<6}{:>8}{:>16}{:>16}{:>12}{:>16}{verdict}",
+            stats.count,
+            stats.instructions / stats.count,
+            stats.max,
+            stats.sdk_calls / stats.count,
+            limit.map_or("-".to_string(), |limit| limit.to_string()),
+        );
+    }
+    over
+}
+
+/// Which instructions of an exchange are charged to it.
+#[derive(Clone, Copy, PartialEq)]
+enum Phase {
+    // all of them, until the app first calls io_exchange
+    Command,
+    // only the REVIEW_WORK, while the review waits for the user
+    Review,
+    // none, once the approval sends the reply
+    Sent,
+}
+
+struct Frame {
+    function: usize,
+    // where the function returns to, if its call was seen
+    ret: u32,
+}
+
+/// The instructions one exchange took, per call stack.
+struct ExchangeProfile {
+    stacks: HashMap<Vec<usize>, u64>,
+    sdk_calls: u64,
+}
+
+struct Profiler<'a> {
+    symbols: &'a Symbols,
+    gdb: Gdb,
+    step_sdk: bool,
+    stack: Vec<Frame>,
+    pc: u32,
+    // where the app may resume once the SDK call it is in returns
+    resume_at: Vec<u32>,
+    // the start of io_exchange, which ends the Command and Review phases
+    io_exchange: u32,
+    // the REVIEW_WORK functions found in the ELF
+    review_work: Vec<usize>,
+}
+
+impl<'a> Profiler<'a> {
+    fn new(symbols: &'a Symbols, gdb: Gdb, step_sdk: bool) -> Profiler<'a> {
+        Profiler {
+            symbols,
+            gdb,
+            step_sdk,
+            stack: Vec::new(),
+            pc: 0,
+            resume_at: Vec::new(),
+            io_exchange: 0,
+            review_work: Vec::new(),
+        }
+    }
+
+    /// Runs the app until it first waits for a command, in io_exchange, so
+    /// that every exchange starts from an SDK call whose return is known.
+    /// It also finds the REVIEW_WORK functions.
+    fn start(&mut self) -> Result {
+        self.io_exchange = self
+            .symbols
+            .find("io_exchange")
+            .ok_or(Error::Elf("no io_exchange symbol"))?
+            .start;
+        // a function inlined into its callers would go uncharged
+        for name in REVIEW_WORK {
+            let function = self
+                .symbols
+                .find(name)
+                .and_then(|function| self.symbols.lookup(function.start))
+                .ok_or(Error::Elf("no review_presign or review_validate symbol"))?;
+            self.review_work.push(function);
+        }
+        self.gdb.insert_breakpoint(self.io_exchange)?;
+        self.gdb.resume()?;
+        if !self.gdb.wait_stop(Duration::from_secs(30))? {
+            return Err(Error::Timeout("the app never reached io_exchange"));
+        }
+        self.gdb.remove_breakpoint(self.io_exchange)?;
+        let registers = self.gdb.registers()?;
+        self.pc = registers.pc;
+        for pc in [registers.lr & !1, self.pc] {
+            if let Some(function) = self.symbols.lookup(pc) {
+                self.stack.push(Frame { function, ret: 0 });
+            }
+        }
+        if let Some(frame) = self.stack.last_mut() {
+            frame.ret = registers.lr & !1;
+        }
+        while self.symbols.is_app(self.pc) {
+            let previous = self.pc;
+            self.gdb.step()?;
+            self.wait(None, None)?;
+            let registers = self.gdb.registers()?;
+            self.pc = registers.pc;
+            if !self.symbols.is_app(self.pc) {
+                self.left_app(previous, registers.lr);
+            }
+        }
+        Ok(())
+    }
+
+    /// Sends 'command' and profiles the app until its reply arrives,
+    /// approving any review it starts. Past the first call to io_exchange,
+    /// only the review work is charged (see Phase).
+    fn exchange(
+        &mut self,
+        speculos: &Speculos,
+        transport: &mut ApduTransport,
+        command: &[u8],
+        model: &str,
+    ) -> Result<(Vec<u8>, ExchangeProfile)> {
+        let mut profile = ExchangeProfile {
+            stacks: HashMap::new(),
+            sdk_calls: 0,
+        };
+        let mut receiver = transport.try_clone()?;
+        let (tx, rx) = mpsc::channel();
+        transport.send_raw(command)?;
+        thread::spawn(move || {
+            let _ = tx.send(receiver.receive());
+        });
+        let review = Some((speculos, model));
+        let mut phase = Phase::Command;
+
+        loop {
+            if self.symbols.is_app(self.pc) || self.step_sdk {
+                let previous = self.pc;
+                self.gdb.step()?;
+                let reply = self.wait(Some(&rx), review)?;
+                let registers = self.gdb.registers()?;
+                if let Some(reply) = reply {
+                    self.pc = registers.pc;
+                    return Ok((reply, profile));
+                }
+                // a stop on a signal has not executed anything yet
+                if registers.pc == previous {
+                    continue;
+                }
+                let charging = self.charging(phase);
+                if charging {
+                    self.charge(&mut profile, previous);
+                }
+                self.pc = registers.pc;
+                if self.symbols.is_app(self.pc) {
+                    self.track(previous, registers.lr);
+                } else if self.symbols.is_app(previous) {
+                    if charging {
+                        profile.sdk_calls += 1;
+                    }
+                    self.left_app(previous, registers.lr);
+                }
+                if self.pc == self.io_exchange {
+                    phase = match phase {
+                        Phase::Command => Phase::Review,
+                        _ if self.in_review_work() => Phase::Sent,
+                        phase => phase,
+                    };
+                }
+            } else {
+                // let the SDK call run at full speed until it returns
+                for &address in &self.resume_at {
+                    self.gdb.insert_breakpoint(address)?;
+                }
+                self.gdb.resume()?;
+                let reply = self.wait(Some(&rx), review)?;
+                for &address in &self.resume_at {
+                    self.gdb.remove_breakpoint(address)?;
+                }
+                let registers = self.gdb.registers()?;
+                if self.symbols.is_app(registers.pc) {
+                    self.pc = registers.pc;
+                    self.track(self.pc, registers.lr);
+                }
+                if let Some(reply) = reply {
+                    return Ok((reply, profile));
+                }
+            }
+        }
+    }
+
+    /// Waits for the target to stop. If the reply on 'rx' arrives first, the
+    /// exchange is over: the target is interrupted and the reply returned.
+    /// Meanwhile, reviews are walked to approval.
+    fn wait(
+        &mut self,
+        rx: Option<&mpsc::Receiver<Result<Reply>>>,
+        review: Option<(&Speculos, &str)>,
+    ) -> Result<Option<Vec<u8>>> {
+        let started = Instant::now();
+        let mut last_screen = Vec::new();
+        loop {
+            if self.gdb.wait_stop(Duration::from_millis(20))? {
+                return Ok(None);
+            }
+            if let Some(rx) = rx {
+                if let Ok(reply) = rx.try_recv() {
+                    self.gdb.interrupt()?;
+                    let reply = reply?;
+                    let mut bytes = reply.data;
+                    bytes.extend(reply.sw.to_be_bytes());
+                    return Ok(Some(bytes));
+                }
+            }
+            if started.elapsed() > Duration::from_secs(120) {
+                return Err(Error::Timeout("the app is stuck"));
+            }
+            if let Some((speculos, model)) = review {
+                let screen = speculos.screen()?;
+                // wait for each press to be rendered before pressing again
+                if screen.is_empty() || screen == last_screen || is_idle(&screen) {
+                    continue;
+                }
+                speculos.press(next_button(&screen, model))?;
+                last_screen = screen;
+            }
+        }
+    }
+
+    /// Returns whether the instruction about to run is charged in 'phase'.
+    fn charging(&self, phase: Phase) -> bool {
+        match phase {
+            Phase::Command => true,
+            Phase::Review => self.in_review_work(),
+            Phase::Sent => false,
+        }
+    }
+
+    /// Returns whether a REVIEW_WORK function is on the call stack.
+    fn in_review_work(&self) -> bool {
+        self.stack
+            .iter()
+            .any(|frame| self.review_work.contains(&frame.function))
+    }
+
+    /// Charges the instruction at 'pc' to the current call stack.
+    fn charge(&self, profile: &mut ExchangeProfile, pc: u32) {
+        let mut stack: Vec<usize> = self.stack.iter().map(|frame| frame.function).collect();
+        if !self.symbols.is_app(pc) {
+            stack.push(SDK);
+        }
+        *profile.stacks.entry(stack).or_default() += 1;
+    }
+
+    /// Records where the app resumes after the SDK call made by the
+    /// instruction at 'pc': the next instruction, whether it is 2 or 4 bytes
+    /// long, or the return address of a call.
+    fn left_app(&mut self, pc: u32, lr: u32) {
+        self.resume_at = vec![pc + 2, pc + 4];
+        if self.symbols.is_app(lr & !1) && !self.resume_at.contains(&(lr & !1)) {
+            self.resume_at.push(lr & !1);
+        }
+    }
+
+    /// Updates the call stack after the app moved from 'previous' to the
+    /// current pc.
+    fn track(&mut self, previous: u32, lr: u32) {
+        let Some(function) = self.symbols.lookup(self.pc) else {
+            return;
+        };
+        if self.stack.last().map_or(false, |frame| frame.ret == self.pc) {
+            self.stack.pop();
+        }
+        if self.stack.last().map(|frame| frame.function) == Some(function) {
+            return;
+        }
+        if self.pc == self.symbols.function(function).start {
+            let ret = lr & !1;
+            if ret == previous + 2 || ret == previous + 4 {
+                self.stack.push(Frame { function, ret });
+                return;
+            }
+            // a tail call takes the place of its caller
+            if let Some(frame) = self.stack.last_mut() {
+                frame.function = function;
+                return;
+            }
+        }
+        // anything else, such as the longjmp of an exception, unwinds to the
+        // innermost frame of the function it lands in
+        match self.stack.iter().rposition(|frame| frame.function == function) {
+            Some(depth) => self.stack.truncate(depth + 1),
+            None => {
+                self.stack.clear();
+                self.stack.push(Frame { function, ret: 0 });
+            }
+        }
+    }
+
+    /// Formats a stack as a line of folded stacks, under the INS.
+    fn fold(&self, ins: u8, stack: &[usize]) -> String {
+        let mut folded = format!("INS_0x{ins:02x}");
+        for &function in stack {
+            folded.push(';');
+            folded.push_str(if function == SDK {
+                "[sdk]"
+            } else {
+                &self.symbols.function(function).name
+            });
+        }
+        folded
+    }
+}
+
+use thiserror::Error;
+
+#[derive(Error, Debug)]
+pub enum Error {
+    #[error("IO error: {0}")]
+    Io(#[from] std::io::Error),
+    #[error("Speculos API error: {0}")]
+    Api(#[from] Box<ureq::Error>),
+    #[error("JSON error: {0}")]
+    Json(#[from] serde_json::Error),
+    #[error("gdb error: {0}")]
+    Gdb(String),
+    #[error("ELF error: {0}")]
+    Elf(&'static str),
+    #[error("trace error: {0}")]
+    Trace(&'static str),
+    #[error("{0} INS over budget")]
+    Budget(usize),
+    #[error("timeout: {0}")]
+    Timeout(&'static str),
+    #[error("bad argument: {0}")]
+    Usage(String),
+}
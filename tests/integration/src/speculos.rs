@@ -0,0 +1,169 @@
+use std::io::{Read, Write};
+use std::net::TcpStream;
+use std::path::Path;
+use std::process::{Child, Command, Stdio};
+use std::thread;
+use std::time::{Duration, Instant};
+
+use serde_json::Value;
+
+use super::{APDUCommand, Error, Result};
+
+/// A Speculos instance running the app, driven through its APDU port and its
+/// REST API.
+pub struct Speculos {
+    child: Child,
+    apdu_port: u16,
+    api: String,
+}
+
+/// The reply to one APDU: the payload and the status word.
+pub struct Reply {
+    pub data: Vec<u8>,
+    pub sw: u16,
+}
+
+impl Speculos {
+    pub fn launch(speculos: &Path, elf: &Path, model: &str, apdu_port: u16, api_port: u16) -> Result<Speculos> {
+        let speculos = Speculos::spawn(speculos, elf, model, apdu_port, api_port, &[])?;
+        speculos.wait_ready(Duration::from_secs(30))?;
+        Ok(speculos)
+    }
+
+    /// Starts Speculos with 'args' added, without waiting for it to be ready:
+    /// with --debug, the app only starts once a debugger lets it run.
+    pub fn spawn(
+        speculos: &Path,
+        elf: &Path,
+        model: &str,
+        apdu_port: u16,
+        api_port: u16,
+        args: &[&str],
+    ) -> Result<Speculos> {
+        let child = Command::new(speculos)
+            .arg("--model")
+            .arg(model)
+            .arg("--display")
+            .arg("headless")
+            .arg("--apdu-port")
+            .arg(apdu_port.to_string())
+            .arg("--api-port")
+            .arg(api_port.to_string())
+            .args(args)
+            .arg(elf)
+            .stdout(Stdio::null())
+            .stderr(Stdio::null())
+            .spawn()?;
+        Ok(Speculos {
+            child,
+            apdu_port,
+            api: format!("http://127.0.0.1:{api_port}"),
+        })
+    }
+
+    pub fn wait_ready(&self, timeout: Duration) -> Result {
+        let start = Instant::now();
+        while start.elapsed() < timeout {
+            if TcpStream::connect(("127.0.0.1", self.apdu_port)).is_ok() && self.screen().is_ok() {
+                return Ok(());
+            }
+            thread::sleep(Duration::from_millis(200));
+        }
+        Err(Error::Timeout("speculos did not start"))
+    }
+
+    /// Opens a connection to the APDU port. Speculos frames every APDU with
+    /// its length as a big-endian u32, and every reply with the length of the
+    /// payload, followed by the payload and the status word.
+    pub fn connect(&self) -> Result<ApduTransport> {
+        let stream = TcpStream::connect(("127.0.0.1", self.apdu_port))?;
+        stream.set_nodelay(true)?;
+        Ok(ApduTransport { stream })
+    }
+
+    /// Returns the texts currently displayed.
+    pub fn screen(&self) -> Result<Vec<String>> {
+        let events: Value = ureq::get(&format!("{}/events?currentscreenonly=true", self.api))
+            .call()
+            .map_err(Box::new)?
+            .into_json()?;
+        Ok(events["events"]
+            .as_array()
+            .map(|events| {
+                events
+                    .iter()
+                    .filter_map(|event| event["text"].as_str().map(str::to_string))
+                    .collect()
+            })
+            .unwrap_or_default())
+    }
+
+    /// Presses and releases "left", "right" or "both".
+    pub fn press(&self, button: &str) -> Result {
+        ureq::post(&format!("{}/button/{button}", self.api))
+            .send_json(serde_json::json!({ "action": "press-and-release" }))
+            .map_err(Box::new)?;
+        Ok(())
+    }
+}
+
+impl Drop for Speculos {
+    fn drop(&mut self) {
+        let _ = self.child.kill();
+        let _ = self.child.wait();
+    }
+}
+
+pub struct ApduTransport {
+    stream: TcpStream,
+}
+
+impl ApduTransport {
+    pub fn send(&mut self, command: &APDUCommand) -> Result {
+        let mut apdu = vec![command.cla, command.ins, command.p1, command.p2, command.data.len() as u8];
+        apdu.extend(&command.data);
+        self.send_raw(&apdu)
+    }
+
+    pub fn send_raw(&mut self, apdu: &[u8]) -> Result {
+        self.stream.write_all(&(apdu.len() as u32).to_be_bytes())?;
+        self.stream.write_all(apdu)?;
+        Ok(())
+    }
+
+    pub fn receive(&mut self) -> Result<Reply> {
+        let mut len = [0u8; 4];
+        self.stream.read_exact(&mut len)?;
+        let mut data = vec![0u8; u32::from_be_bytes(len) as usize];
+        self.stream.read_exact(&mut data)?;
+        let mut sw = [0u8; 2];
+        self.stream.read_exact(&mut sw)?;
+        Ok(Reply {
+            data,
+            sw: u16::from_be_bytes(sw),
+        })
+    }
+
+    pub fn try_clone(&self) -> Result<ApduTransport> {
+        Ok(ApduTransport {
+            stream: self.stream.try_clone()?,
+        })
+    }
+}
+
+pub fn is_idle(screen: &[String]) -> bool {
+    screen.iter().any(|text| text == "Waiting for" || text == "commands...")
+}
+
+/// Picks the button that moves a review towards approval: on Nano S, both
+/// buttons go to the next field and the right button approves; on Nano X the
+/// right button walks the flow and both buttons select "YES".
+pub fn next_button(screen: &[String], model: &str) -> &'static str {
+    let approval = screen.iter().any(|text| text.ends_with('?'));
+    match model {
+        "nanos" if approval => "right",
+        "nanos" => "both",
+        _ if approval && screen.iter().any(|text| text == "YES") => "both",
+        _ => "right",
+    }
+}
@@ -0,0 +1,41 @@
+use std::path::Path;
+
+use super::{Error, Result};
+
+/// One exchange of a trace recorded by the native runner (see
+/// tests/native/native.h): the command, and the reply with its status word.
+pub struct Exchange {
+    pub command: Vec<u8>,
+    pub reply: Vec<u8>,
+}
+
+const MAGIC: &[u8] = b"HNTRACE1";
+
+/// Reads the exchanges of a trace. Every record is the length of the
+/// command and of the reply (u16), the time the app took (u32), all
+/// little-endian, then the command and the reply.
+pub fn read(path: &Path) -> Result<Vec<Exchange>> {
+    let bytes = std::fs::read(path)?;
+    if !bytes.starts_with(MAGIC) {
+        return Err(Error::Trace("not a trace"));
+    }
+    let mut exchanges = Vec::new();
+    let mut rest = &bytes[MAGIC.len()..];
+    while !rest.is_empty() {
+        if rest.len() < 8 {
+            return Err(Error::Trace("truncated record header"));
+        }
+        let command_len = u16::from_le_bytes([rest[0], rest[1]]) as usize;
+        let reply_len = u16::from_le_bytes([rest[2], rest[3]]) as usize;
+        rest = &rest[8..];
+        if command_len == 0 || rest.len() < command_len + reply_len {
+            return Err(Error::Trace("truncated record"));
+        }
+        exchanges.push(Exchange {
+            command: rest[..command_len].to_vec(),
+            reply: rest[command_len..command_len + reply_len].to_vec(),
+        });
+        rest = &rest[command_len + reply_len..];
+    }
+    Ok(exchanges)
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// native_set_seed derives the seed of every key from a BIP-39 mnemonic,
+// without a passphrase, as Speculos does.
+void native_set_seed(const char *mnemonic);
+
+// native_ux_respond answers the review started by the last command, if any:
+// it approves it, or rejects it when 'reject' is set. io_exchange calls it
+// when a command defers its reply.
+void native_ux_respond(bool reject);
+
+// helium_native_main is the dispatch loop of src/main.c.
+void helium_native_main(void);
+
+// native_set_replayable_rng makes cx_rng return a fixed sequence, so that
+// signatures made with a random nonce (see sign_stream_start) come out the
+// same when a trace is recorded and replayed. Such signatures give the key
+// away to anyone who knows the sequence: use it with test seeds only.
+void native_set_replayable_rng(void);
+
+// A trace holds APDU exchanges, so that a session can be replayed against
+// another build of the app and the replies compared. It starts with the
+// 8 bytes "HNTRACE1", followed by one record per exchange: the length of
+// the command and of the reply (2 bytes each, little-endian), the time the
+// reply took in microseconds (4 bytes, little-endian), the command, and the
+// reply with its status word.
+//
+// trace_record_open creates the trace at 'path', and trace_record_exchange
+// appends an exchange to it.
+bool trace_record_open(const char *path);
+void trace_record_exchange(const uint8_t *command, uint16_t command_len, const uint8_t *reply, uint16_t reply_len,
+                           uint32_t micros);
+
+// trace_replay_open opens the trace at 'path'. trace_replay_next reads the
+// next command of at most 'max' bytes into 'command', and returns false
+// after the last one; trace_replay_check compares the reply to it with the
+// recorded one, and counts its time. trace_replay_report prints the number
+// of exchanges, those that differ and their mean times per INS, and returns
+// the exit status of the replay: 0 if every reply was the same.
+bool trace_replay_open(const char *path);
+bool trace_replay_next(uint8_t *command, uint16_t max, uint16_t *command_len);
+void trace_replay_check(const uint8_t *reply, uint16_t reply_len, uint32_t micros);
+int trace_replay_report(void);
@@ -0,0 +1,330 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "os.h"
+#include "helium_settings.h"
+#include "native.h"
+
+// The APDUs are framed as on the APDU port of Speculos. A command is its
+// length (4 bytes, big-endian) followed by its bytes; a reply is the length
+// of its data without the status word (4 bytes, big-endian), then the data
+// and the status word. One client is served at a time.
+//
+// With --record, every exchange served is also appended to a trace (see
+// native.h). With --replay, the commands come from a trace instead of a
+// client, and the replies are compared with the recorded ones. With
+// --forward, the app does not run: the commands, from a client or a trace,
+// are relayed to another APDU port, such as the one of speculos, so that a
+// session with it can be recorded, or a trace replayed into it. With
+// --expert, transaction reviews are condensed as in expert review mode.
+
+#define DEFAULT_PORT 9999
+#define DEFAULT_SEED "glory promote mansion idle axis finger extra february uncover one trip resource lawn " \
+                     "turtle enact monster seven myth punch hobby comfort wild raise skin"
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static int server = -1;
+static int client = -1;
+static int upstream = -1;
+static bool reject_reviews;
+static bool recording;
+static bool replaying;
+
+// the command being answered, kept for the trace
+static uint8_t command[IO_APDU_BUFFER_SIZE];
+static uint16_t command_len;
+static uint64_t command_start;
+static bool command_pending;
+
+static uint64_t now_micros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static bool read_all(int fd, uint8_t *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = read(fd, buf, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool write_all(int fd, const uint8_t *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+static void drop_client(void) {
+    if (client >= 0) {
+        close(client);
+        client = -1;
+    }
+}
+
+static void accept_client(void) {
+    int one = 1;
+    while (client < 0) {
+        client = accept(server, NULL, NULL);
+    }
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// native_send writes a reply of 'tx' bytes, the status word included. A
+// client that went away is dropped; the next command comes from the next
+// one.
+static void native_send(unsigned short tx) {
+    uint8_t header[4] = {0, 0, (tx - 2) >> 8, (tx - 2) & 0xFF};
+    uint32_t micros = now_micros() - command_start;
+
+    if (replaying) {
+        if (command_pending) {
+            trace_replay_check(G_io_apdu_buffer, tx, micros);
+        }
+        command_pending = false;
+        return;
+    }
+    if (recording && command_pending) {
+        trace_record_exchange(command, command_len, G_io_apdu_buffer, tx, micros);
+    }
+    command_pending = false;
+    if (client >= 0 && !(write_all(client, header, sizeof(header)) && write_all(client, G_io_apdu_buffer, tx))) {
+        drop_client();
+    }
+}
+
+// replay_receive takes the next command from the trace, and ends the
+// replay after the last one. A command the app did not answer, because an
+// exception restarted it, counts as differing.
+static unsigned short replay_receive(void) {
+    uint16_t len;
+    if (command_pending) {
+        trace_replay_check(NULL, 0, now_micros() - command_start);
+    }
+    if (!trace_replay_next(G_io_apdu_buffer, sizeof(G_io_apdu_buffer), &len)) {
+        exit(trace_replay_report());
+    }
+    return len;
+}
+
+static unsigned short client_receive(void) {
+    for (;;) {
+        uint8_t header[4];
+        accept_client();
+        if (!read_all(client, header, sizeof(header))) {
+            drop_client();
+            continue;
+        }
+        uint32_t len = ((uint32_t)header[0] << 24) | (header[1] << 16) | (header[2] << 8) | header[3];
+        if (len == 0 || len > sizeof(G_io_apdu_buffer) || !read_all(client, G_io_apdu_buffer, len)) {
+            drop_client();
+            continue;
+        }
+        return len;
+    }
+}
+
+static unsigned short native_receive(void) {
+    unsigned short len = replaying ? replay_receive() : client_receive();
+    memcpy(command, G_io_apdu_buffer, len);
+    command_len = len;
+    command_pending = true;
+    command_start = now_micros();
+    return len;
+}
+
+// io_exchange sends the reply, if any, then waits for the next command. A
+// command that deferred its reply to the UI gets it from native_ux_respond
+// first, which sends it through io_exchange with IO_RETURN_AFTER_TX.
+unsigned short io_exchange(unsigned char channel, unsigned short tx_len) {
+    if (tx_len > 0) {
+        native_send(tx_len);
+    }
+    if (channel & IO_RETURN_AFTER_TX) {
+        return 0;
+    }
+    if (channel & IO_ASYNCH_REPLY) {
+        native_ux_respond(reject_reviews);
+    }
+    return native_receive();
+}
+
+// forward_exchange sends the command in G_io_apdu_buffer upstream, and
+// leaves the reply there. It returns the length of the reply.
+static unsigned short forward_exchange(unsigned short len) {
+    uint8_t header[4] = {0, 0, len >> 8, len & 0xFF};
+    if (!write_all(upstream, header, sizeof(header)) || !write_all(upstream, G_io_apdu_buffer, len) ||
+        !read_all(upstream, header, sizeof(header))) {
+        fprintf(stderr, "upstream APDU port closed\n");
+        exit(1);
+    }
+    uint32_t tx = (((uint32_t)header[0] << 24) | (header[1] << 16) | (header[2] << 8) | header[3]) + 2;
+    if (tx > sizeof(G_io_apdu_buffer) || !read_all(upstream, G_io_apdu_buffer, tx)) {
+        fprintf(stderr, "upstream reply too long\n");
+        exit(1);
+    }
+    return tx;
+}
+
+static void forward(void) {
+    for (;;) {
+        native_send(forward_exchange(native_receive()));
+    }
+}
+
+static int connect_upstream(const char *address) {
+    struct sockaddr_in addr;
+    char host[64];
+    const char *colon = strrchr(address, ':');
+    int one = 1;
+    int fd;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    if (colon == NULL || colon - address >= (ptrdiff_t)sizeof(host)) {
+        return -1;
+    }
+    memcpy(host, address, colon - address);
+    host[colon - address] = 0;
+    addr.sin_port = htons(atoi(colon + 1));
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+        return -1;
+    }
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        return -1;
+    }
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [--apdu-port PORT] [--seed MNEMONIC] [--reject] [--expert]\n"
+            "          [--record TRACE | --replay TRACE] [--forward HOST:PORT]\n",
+            name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    int port = DEFAULT_PORT;
+    const char *mnemonic = DEFAULT_SEED;
+    const char *record = NULL;
+    const char *replay = NULL;
+    const char *forward_to = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--apdu-port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            mnemonic = argv[++i];
+        } else if (strcmp(argv[i], "--reject") == 0) {
+            reject_reviews = true;
+        } else if (strcmp(argv[i], "--expert") == 0) {
+            settings_set_expert_review(true);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay = argv[++i];
+        } else if (strcmp(argv[i], "--forward") == 0 && i + 1 < argc) {
+            forward_to = argv[++i];
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (record && replay) {
+        usage(argv[0]);
+    }
+    native_set_seed(mnemonic);
+    if (record) {
+        if (!trace_record_open(record)) {
+            perror(record);
+            return 1;
+        }
+        recording = true;
+    }
+    if (replay) {
+        if (!trace_replay_open(replay)) {
+            fprintf(stderr, "%s: not a trace\n", replay);
+            return 1;
+        }
+        replaying = true;
+    }
+    if (forward_to) {
+        upstream = connect_upstream(forward_to);
+        if (upstream < 0) {
+            fprintf(stderr, "cannot connect to %s\n", forward_to);
+            return 1;
+        }
+    } else if (record || replay) {
+        // the app's own random nonces must be the same in both runs
+        native_set_replayable_rng();
+    }
+    if (forward_to && replay) {
+        forward();
+    }
+
+    // a replay takes its commands from the trace only
+    if (!replay) {
+        struct sockaddr_in addr;
+        int one = 1;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        server = socket(AF_INET, SOCK_STREAM, 0);
+        setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (server < 0 || bind(server, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(server, 1) < 0) {
+            perror("apdu port");
+            return 1;
+        }
+        fprintf(stderr, "APDU server listening on 127.0.0.1:%d\n", port);
+    }
+    if (forward_to) {
+        forward();
+    }
+
+    // as on the device, an exception nothing catches restarts the app
+    for (;;) {
+        BEGIN_TRY {
+            TRY {
+                helium_native_main();
+            }
+            CATCH_OTHER(e) {
+                fprintf(stderr, "restarting after exception 0x%04x\n", e);
+            }
+            FINALLY {
+            }
+        }
+        END_TRY;
+    }
+}
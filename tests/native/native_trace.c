@@ -0,0 +1,141 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "native.h"
+
+// The trace format is described in native.h.
+
+#define TRACE_MAGIC "HNTRACE1"
+#define TRACE_MAX_APDU 512
+// mismatches are all counted, but only the first few are printed
+#define MISMATCHES_SHOWN 10
+
+static FILE *trace;
+
+typedef struct {
+    uint16_t command_len;
+    uint16_t reply_len;
+    uint32_t micros;
+    uint8_t command[TRACE_MAX_APDU];
+    uint8_t reply[TRACE_MAX_APDU];
+} trace_record_t;
+
+// what the replay has seen, per INS
+static struct {
+    uint32_t count;
+    uint32_t mismatches;
+    uint64_t recorded_micros;
+    uint64_t replayed_micros;
+    uint32_t replayed_max;
+} stats[256];
+
+static trace_record_t current;
+static uint32_t record_index;
+static uint32_t mismatches;
+
+static void put_le(uint8_t *dst, uint32_t n, uint8_t len) {
+    for (uint8_t i = 0; i < len; i++) {
+        dst[i] = n >> (8 * i);
+    }
+}
+
+static uint32_t get_le(const uint8_t *src, uint8_t len) {
+    uint32_t n = 0;
+    for (uint8_t i = 0; i < len; i++) {
+        n |= (uint32_t)src[i] << (8 * i);
+    }
+    return n;
+}
+
+bool trace_record_open(const char *path) {
+    trace = fopen(path, "wb");
+    return trace != NULL && fwrite(TRACE_MAGIC, 1, 8, trace) == 8 && fflush(trace) == 0;
+}
+
+void trace_record_exchange(const uint8_t *command, uint16_t command_len, const uint8_t *reply, uint16_t reply_len,
+                           uint32_t micros) {
+    uint8_t header[8];
+    put_le(header, command_len, 2);
+    put_le(&header[2], reply_len, 2);
+    put_le(&header[4], micros, 4);
+    // each exchange is flushed, so that a trace survives the runner being
+    // killed
+    if (fwrite(header, 1, sizeof(header), trace) != sizeof(header) ||
+        fwrite(command, 1, command_len, trace) != command_len || fwrite(reply, 1, reply_len, trace) != reply_len ||
+        fflush(trace) != 0) {
+        perror("trace");
+        exit(1);
+    }
+}
+
+bool trace_replay_open(const char *path) {
+    char magic[8];
+    trace = fopen(path, "rb");
+    return trace != NULL && fread(magic, 1, sizeof(magic), trace) == sizeof(magic) &&
+           memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0;
+}
+
+bool trace_replay_next(uint8_t *command, uint16_t max, uint16_t *command_len) {
+    uint8_t header[8];
+    if (fread(header, 1, sizeof(header), trace) != sizeof(header)) {
+        return false;
+    }
+    current.command_len = get_le(header, 2);
+    current.reply_len = get_le(&header[2], 2);
+    current.micros = get_le(&header[4], 4);
+    if (current.command_len == 0 || current.command_len > max || current.reply_len > TRACE_MAX_APDU ||
+        fread(current.command, 1, current.command_len, trace) != current.command_len ||
+        fread(current.reply, 1, current.reply_len, trace) != current.reply_len) {
+        fprintf(stderr, "trace: record %u is truncated or too long\n", record_index);
+        exit(2);
+    }
+    memcpy(command, current.command, current.command_len);
+    *command_len = current.command_len;
+    record_index++;
+    return true;
+}
+
+static void print_hex(const char *label, const uint8_t *data, uint16_t len) {
+    fprintf(stderr, "  %s (%u bytes): ", label, len);
+    for (uint16_t i = 0; i < len && i < 48; i++) {
+        fprintf(stderr, "%02x", data[i]);
+    }
+    fprintf(stderr, len > 48 ? "...\n" : "\n");
+}
+
+void trace_replay_check(const uint8_t *reply, uint16_t reply_len, uint32_t micros) {
+    uint8_t ins = current.command_len > 1 ? current.command[1] : 0;
+    stats[ins].count++;
+    stats[ins].recorded_micros += current.micros;
+    stats[ins].replayed_micros += micros;
+    if (micros > stats[ins].replayed_max) {
+        stats[ins].replayed_max = micros;
+    }
+    if (reply_len == current.reply_len && memcmp(reply, current.reply, reply_len) == 0) {
+        return;
+    }
+    stats[ins].mismatches++;
+    if (mismatches++ < MISMATCHES_SHOWN) {
+        fprintf(stderr, "record %u (INS 0x%02x): reply differs\n", record_index - 1, ins);
+        print_hex("recorded", current.reply, current.reply_len);
+        print_hex("replayed", reply, reply_len);
+    }
+}
+
+int trace_replay_report(void) {
+    uint32_t total = 0;
+    printf("%-6s %8s %10s %14s %14s %12s\n", "INS", "count", "differ", "recorded (us)", "replayed (us)", "max (us)");
+    for (int ins = 0; ins < 256; ins++) {
+        if (stats[ins].count == 0) {
+            continue;
+        }
+        total += stats[ins].count;
+        printf("0x%02x   %8u %10u %14.1f %14.1f %12u\n", ins, stats[ins].count, stats[ins].mismatches,
+               (double)stats[ins].recorded_micros / stats[ins].count,
+               (double)stats[ins].replayed_micros / stats[ins].count, stats[ins].replayed_max);
+    }
+    printf("%u exchanges replayed, %u differ\n", total, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "os.h"
+#include "ux.h"
+#include "helium_ux.h"
+#include "helium_review.h"
+#include "native.h"
+
+ux_state_t G_ux;
+
+static bool review_pending;
+
+void ux_stack_push(void) {
+}
+
+void ux_flow_init(unsigned int stack_slot, const ux_flow_step_t *const *steps, const ux_flow_step_t *start_step) {
+    UNUSED(stack_slot); UNUSED(steps); UNUSED(start_step);
+}
+
+void ui_idle(void) {
+    review_wipe();
+}
+
+// Reviews are not shown; the field tables, or the summary of an expert
+// review, are still formatted, so that the formatters take their share of
+// the time.
+void ui_review_display(void) {
+    if (review.condensed) {
+        review_load_summary();
+    } else {
+        for (uint8_t i = 0; i < review.count; i++) {
+            review_load_field(i);
+        }
+    }
+    review_load_prompt();
+    review_pending = true;
+}
+
+void native_ux_respond(bool reject) {
+    if (!review_pending) {
+        return;
+    }
+    review_pending = false;
+    review_validate(!reject);
+}
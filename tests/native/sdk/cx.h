@@ -0,0 +1,62 @@
+#pragma once
+
+// The crypto API used by the app, on top of OpenSSL (see sdk_native.c).
+
+#include <stdint.h>
+
+#define CX_LAST 1
+#define CX_CURVE_Ed25519 2
+#define CX_RND_RFC6979 4
+#define CX_SHA512 5
+#define CX_SHA256 6
+
+typedef struct {
+    int algo;
+} cx_hash_t;
+
+// the states are an OpenSSL SHA256_CTX and SHA512_CTX
+typedef struct {
+    cx_hash_t header;
+    uint8_t state[128];
+} cx_sha256_t;
+
+typedef struct {
+    cx_hash_t header;
+    uint8_t state[256];
+} cx_sha512_t;
+
+typedef struct {
+    int curve;
+    unsigned int d_len;
+    unsigned char d[32];
+} cx_ecfp_private_key_t;
+
+// W is the uncompressed point as on the device: 0x04, then X and Y
+// big-endian. Only what extract_pubkey_bytes reads is filled in: Y, and the
+// parity of X.
+typedef struct {
+    int curve;
+    unsigned int W_len;
+    unsigned char W[65];
+} cx_ecfp_public_key_t;
+
+int cx_sha256_init(cx_sha256_t *hash);
+int cx_sha512_init(cx_sha512_t *hash);
+int cx_hash(cx_hash_t *hash, int mode, const unsigned char *in, unsigned int len, unsigned char *out,
+            unsigned int out_len);
+int cx_ecfp_init_private_key(int curve, const unsigned char *raw_key, unsigned int key_len,
+                             cx_ecfp_private_key_t *pvkey);
+int cx_ecfp_init_public_key(int curve, const unsigned char *raw_key, unsigned int key_len,
+                            cx_ecfp_public_key_t *key);
+int cx_ecfp_generate_pair(int curve, cx_ecfp_public_key_t *pubkey, cx_ecfp_private_key_t *privkey, int keepprivate);
+int cx_eddsa_sign(const cx_ecfp_private_key_t *pvkey, int mode, int hashID, const unsigned char *hash,
+                  unsigned int hash_len, const unsigned char *ctx, unsigned int ctx_len, unsigned char *sig,
+                  unsigned int sig_len, unsigned int *info);
+unsigned char *cx_rng(unsigned char *buffer, unsigned int len);
+
+// big-endian modular arithmetic, as on the device
+void cx_math_modm(unsigned char *v, unsigned int len_v, const unsigned char *m, unsigned int len_m);
+void cx_math_multm(unsigned char *r, const unsigned char *a, const unsigned char *b, const unsigned char *m,
+                   unsigned int len);
+void cx_math_addm(unsigned char *r, const unsigned char *a, const unsigned char *b, const unsigned char *m,
+                  unsigned int len);
@@ -0,0 +1,98 @@
+#pragma once
+
+// Just enough of the BOLOS SDK for the app to run as a Linux process. The
+// definitions are in sdk_native.c, native_io.c and native_ux.c.
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define UNUSED(x) (void)(x)
+// As on the device, PIC is a call the compiler cannot see through, so that
+// reads of zero-initialized NVM variables are not folded to 0.
+void *pic(void *linked);
+#define PIC(x) pic((void *)(x))
+
+#define IO_APDU_BUFFER_SIZE 260
+extern unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+#define CHANNEL_APDU 0
+#define IO_ASYNCH_REPLY 0x10
+#define IO_RETURN_AFTER_TX 0x20
+unsigned short io_exchange(unsigned char channel, unsigned short tx_len);
+
+#define EXCEPTION_IO_RESET 0x10
+#define INVALID_PARAMETER 2
+
+// The exceptions work as in the SDK: each TRY pushes a context holding a
+// jmp_buf, THROW jumps to the innermost one, and an exception that no CATCH
+// takes is thrown again by END_TRY.
+typedef unsigned short exception_t;
+
+typedef struct try_context_s {
+    jmp_buf jmp_buf;
+    struct try_context_s *previous;
+    exception_t ex;
+} try_context_t;
+
+extern try_context_t *G_try_last_open_context;
+
+void os_longjmp(unsigned int exception) __attribute__((noreturn));
+#define THROW(x) os_longjmp(x)
+
+#define BEGIN_TRY_L(L) \
+    { \
+        try_context_t __try##L; \
+        __try##L.ex = setjmp(__try##L.jmp_buf);
+#define TRY_L(L) \
+        if (__try##L.ex == 0) { \
+            __try##L.previous = G_try_last_open_context; \
+            G_try_last_open_context = &__try##L;
+#define CATCH_L(L, x) \
+            goto __FINALLY##L; \
+        } else if (__try##L.ex == (x)) { \
+            __try##L.ex = 0; \
+            G_try_last_open_context = __try##L.previous;
+#define CATCH_OTHER_L(L, e) \
+            goto __FINALLY##L; \
+        } else { \
+            exception_t e = __try##L.ex; \
+            __try##L.ex = 0; \
+            G_try_last_open_context = __try##L.previous;
+#define CATCH_ALL_L(L) \
+            goto __FINALLY##L; \
+        } else { \
+            __try##L.ex = 0; \
+            G_try_last_open_context = __try##L.previous;
+#define FINALLY_L(L) \
+            goto __FINALLY##L; \
+        } \
+        __FINALLY##L: \
+        if (G_try_last_open_context == &__try##L) { \
+            G_try_last_open_context = __try##L.previous; \
+        }
+#define END_TRY_L(L) \
+        if (__try##L.ex != 0) { \
+            THROW(__try##L.ex); \
+        } \
+    }
+
+#define BEGIN_TRY BEGIN_TRY_L(_)
+#define TRY TRY_L(_)
+#define CATCH(x) CATCH_L(_, x)
+#define CATCH_OTHER(e) CATCH_OTHER_L(_, e)
+#define CATCH_ALL CATCH_ALL_L(_)
+#define FINALLY FINALLY_L(_)
+#define END_TRY END_TRY_L(_)
+
+#define HDW_ED25519_SLIP10 1
+void os_perso_derive_node_bip32_seed_key(unsigned int mode, int curve, const uint32_t *path, unsigned int pathLength,
+                                         unsigned char *privateKey, unsigned char *chain, unsigned char *seed_key,
+                                         unsigned int seed_key_length);
+
+// NVM variables are const, so they sit in read-only pages as on the device;
+// nvm_write makes a page writable on the first store to it (see
+// sdk_native.c). NVM is not kept across runs.
+void nvm_write(void *dst, void *src, unsigned int len);
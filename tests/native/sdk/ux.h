@@ -0,0 +1,22 @@
+#pragma once
+
+// There is no screen: reviews are answered by native_ux.c, and the flows of
+// the Nano X files compiled here are never shown.
+
+#include "os.h"
+
+typedef struct {
+    int stack_count;
+} ux_state_t;
+
+extern ux_state_t G_ux;
+
+typedef struct {
+    int unused;
+} ux_flow_step_t;
+
+#define UX_FLOW_DEF_VALID(name, layout, validate, ...) static const ux_flow_step_t name = {0}
+#define UX_DEF(name, ...) static const ux_flow_step_t *const name[] = {__VA_ARGS__, NULL}
+
+void ux_stack_push(void);
+void ux_flow_init(unsigned int stack_slot, const ux_flow_step_t *const *steps, const ux_flow_step_t *start_step);
@@ -0,0 +1,244 @@
+#define OPENSSL_API_COMPAT 0x10100000L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <openssl/bn.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+
+#include "os.h"
+#include "cx.h"
+#include "native.h"
+
+try_context_t *G_try_last_open_context;
+
+void os_longjmp(unsigned int exception) {
+    if (G_try_last_open_context == NULL) {
+        fprintf(stderr, "uncaught exception 0x%04x\n", exception);
+        exit(1);
+    }
+    longjmp(G_try_last_open_context->jmp_buf, exception);
+}
+
+void *pic(void *linked) {
+    return linked;
+}
+
+// NVM variables are const, as on the device, so they are in read-only pages
+// here; they are made writable on their first store.
+void nvm_write(void *dst, void *src, unsigned int len) {
+    uintptr_t page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)dst & ~(page - 1);
+    if (mprotect((void *)start, (uintptr_t)dst + len - start, PROT_READ | PROT_WRITE) != 0) {
+        perror("nvm_write");
+        exit(1);
+    }
+    memmove(dst, src, len);
+}
+
+static uint8_t seed[64];
+
+void native_set_seed(const char *mnemonic) {
+    const char salt[] = "mnemonic";
+    PKCS5_PBKDF2_HMAC(mnemonic, strlen(mnemonic), (const unsigned char *)salt, sizeof(salt) - 1, 2048, EVP_sha512(),
+                      sizeof(seed), seed);
+}
+
+// SLIP-10 for Ed25519, where every level is hardened.
+void os_perso_derive_node_bip32_seed_key(unsigned int mode, int curve, const uint32_t *path, unsigned int pathLength,
+                                         unsigned char *privateKey, unsigned char *chain, unsigned char *seed_key,
+                                         unsigned int seed_key_length) {
+    UNUSED(mode); UNUSED(curve); UNUSED(seed_key); UNUSED(seed_key_length);
+    const char key[] = "ed25519 seed";
+    uint8_t node[64];
+    uint8_t data[1 + 32 + 4];
+    unsigned int len = sizeof(node);
+
+    HMAC(EVP_sha512(), key, sizeof(key) - 1, seed, sizeof(seed), node, &len);
+    for (unsigned int i = 0; i < pathLength; i++) {
+        uint32_t index = path[i] | 0x80000000;
+        data[0] = 0;
+        memcpy(&data[1], node, 32);
+        data[33] = index >> 24;
+        data[34] = index >> 16;
+        data[35] = index >> 8;
+        data[36] = index;
+        HMAC(EVP_sha512(), &node[32], 32, data, sizeof(data), node, &len);
+    }
+    memcpy(privateKey, node, 32);
+    if (chain != NULL) {
+        memcpy(chain, &node[32], 32);
+    }
+}
+
+int cx_sha256_init(cx_sha256_t *hash) {
+    _Static_assert(sizeof(SHA256_CTX) <= sizeof(hash->state), "cx_sha256_t is too small");
+    hash->header.algo = CX_SHA256;
+    SHA256_Init((SHA256_CTX *)hash->state);
+    return 0;
+}
+
+int cx_sha512_init(cx_sha512_t *hash) {
+    _Static_assert(sizeof(SHA512_CTX) <= sizeof(hash->state), "cx_sha512_t is too small");
+    hash->header.algo = CX_SHA512;
+    SHA512_Init((SHA512_CTX *)hash->state);
+    return 0;
+}
+
+int cx_hash(cx_hash_t *hash, int mode, const unsigned char *in, unsigned int len, unsigned char *out,
+            unsigned int out_len) {
+    UNUSED(out_len);
+    if (hash->algo == CX_SHA512) {
+        SHA512_CTX *ctx = (SHA512_CTX *)((cx_sha512_t *)hash)->state;
+        SHA512_Update(ctx, in, len);
+        if (mode & CX_LAST) {
+            SHA512_Final(out, ctx);
+            SHA512_Init(ctx);
+            return 64;
+        }
+        return 0;
+    }
+    SHA256_CTX *ctx = (SHA256_CTX *)((cx_sha256_t *)hash)->state;
+    SHA256_Update(ctx, in, len);
+    if (mode & CX_LAST) {
+        SHA256_Final(out, ctx);
+        SHA256_Init(ctx);
+        return 32;
+    }
+    return 0;
+}
+
+static bool replayable_rng;
+static uint64_t rng_counter;
+
+void native_set_replayable_rng(void) {
+    replayable_rng = true;
+    rng_counter = 0;
+}
+
+// In replayable mode, every 32 bytes are the SHA-256 of a counter.
+static void replayable_bytes(unsigned char *buffer, unsigned int len) {
+    while (len > 0) {
+        uint8_t block[SHA256_DIGEST_LENGTH];
+        unsigned int n = len < sizeof(block) ? len : sizeof(block);
+        SHA256((const unsigned char *)&rng_counter, sizeof(rng_counter), block);
+        rng_counter++;
+        memcpy(buffer, block, n);
+        buffer += n;
+        len -= n;
+    }
+}
+
+unsigned char *cx_rng(unsigned char *buffer, unsigned int len) {
+    if (replayable_rng) {
+        replayable_bytes(buffer, len);
+        return buffer;
+    }
+    if (RAND_bytes(buffer, len) != 1) {
+        fprintf(stderr, "no randomness\n");
+        exit(1);
+    }
+    return buffer;
+}
+
+// math_op computes r = (a op b) mod m on numbers of 'len' bytes, or reduces
+// 'a' alone when 'b' is NULL; 'r' takes 'len' bytes.
+static void math_op(unsigned char *r, const unsigned char *a, unsigned int len_a, const unsigned char *b,
+                    const unsigned char *m, unsigned int len, bool add) {
+    BN_CTX *ctx = BN_CTX_new();
+    BIGNUM *bn_a = BN_bin2bn(a, len_a, NULL);
+    BIGNUM *bn_m = BN_bin2bn(m, len, NULL);
+    BIGNUM *bn_r = BN_new();
+    if (b == NULL) {
+        BN_nnmod(bn_r, bn_a, bn_m, ctx);
+    } else {
+        BIGNUM *bn_b = BN_bin2bn(b, len, NULL);
+        if (add) {
+            BN_mod_add(bn_r, bn_a, bn_b, bn_m, ctx);
+        } else {
+            BN_mod_mul(bn_r, bn_a, bn_b, bn_m, ctx);
+        }
+        BN_free(bn_b);
+    }
+    BN_bn2binpad(bn_r, r, len);
+    BN_free(bn_a);
+    BN_free(bn_m);
+    BN_free(bn_r);
+    BN_CTX_free(ctx);
+}
+
+void cx_math_modm(unsigned char *v, unsigned int len_v, const unsigned char *m, unsigned int len_m) {
+    unsigned char r[64];
+    math_op(r, v, len_v, NULL, m, len_m, false);
+    memset(v, 0, len_v - len_m);
+    memcpy(&v[len_v - len_m], r, len_m);
+}
+
+void cx_math_multm(unsigned char *r, const unsigned char *a, const unsigned char *b, const unsigned char *m,
+                   unsigned int len) {
+    math_op(r, a, len, b, m, len, false);
+}
+
+void cx_math_addm(unsigned char *r, const unsigned char *a, const unsigned char *b, const unsigned char *m,
+                  unsigned int len) {
+    math_op(r, a, len, b, m, len, true);
+}
+
+int cx_ecfp_init_private_key(int curve, const unsigned char *raw_key, unsigned int key_len,
+                             cx_ecfp_private_key_t *pvkey) {
+    pvkey->curve = curve;
+    pvkey->d_len = key_len;
+    memcpy(pvkey->d, raw_key, key_len);
+    return key_len;
+}
+
+int cx_ecfp_init_public_key(int curve, const unsigned char *raw_key, unsigned int key_len,
+                            cx_ecfp_public_key_t *key) {
+    UNUSED(raw_key);
+    key->curve = curve;
+    key->W_len = key_len;
+    memset(key->W, 0, sizeof(key->W));
+    return key_len;
+}
+
+int cx_ecfp_generate_pair(int curve, cx_ecfp_public_key_t *pubkey, cx_ecfp_private_key_t *privkey, int keepprivate) {
+    UNUSED(keepprivate);
+    uint8_t compressed[32];
+    size_t len = sizeof(compressed);
+    EVP_PKEY *pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, privkey->d, sizeof(privkey->d));
+    EVP_PKEY_get_raw_public_key(pkey, compressed, &len);
+    EVP_PKEY_free(pkey);
+
+    // undo what extract_pubkey_bytes does: Y is the key without its top
+    // bit, which is the parity of X
+    pubkey->curve = curve;
+    pubkey->W_len = 65;
+    memset(pubkey->W, 0, sizeof(pubkey->W));
+    pubkey->W[0] = 0x04;
+    pubkey->W[32] = compressed[31] >> 7;
+    for (int i = 0; i < 32; i++) {
+        pubkey->W[64 - i] = compressed[i];
+    }
+    pubkey->W[33] &= 0x7F;
+    return 0;
+}
+
+int cx_eddsa_sign(const cx_ecfp_private_key_t *pvkey, int mode, int hashID, const unsigned char *hash,
+                  unsigned int hash_len, const unsigned char *ctx, unsigned int ctx_len, unsigned char *sig,
+                  unsigned int sig_len, unsigned int *info) {
+    UNUSED(mode); UNUSED(hashID); UNUSED(ctx); UNUSED(ctx_len); UNUSED(info);
+    size_t len = sig_len;
+    EVP_PKEY *pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, pvkey->d, sizeof(pvkey->d));
+    EVP_MD_CTX *md = EVP_MD_CTX_new();
+    EVP_DigestSignInit(md, NULL, NULL, NULL, pkey);
+    EVP_DigestSign(md, sig, &len, hash, hash_len);
+    EVP_MD_CTX_free(md);
+    EVP_PKEY_free(pkey);
+    return len;
+}
@@ -0,0 +1,154 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "../../src/txns/helium.h"
+#include "../../src/save_context.h"
+
+// Times the transaction builders of src/txns on the host. Each row is the
+// best average, over a few runs, of building and signing a transaction
+// (create_helium_*, which encodes it twice) and of sizing it for its fee
+// (size_helium_*). Signing is stubbed out, so the time is the encoding's.
+// It is in TSC cycles on x86, and in nanoseconds elsewhere.
+
+#define ITERATIONS 200000
+#define RUNS 5
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+commandContext global;
+
+void get_pubkey_bytes(__attribute__((unused)) const accountPath_t *path, uint8_t *out) {
+    memset(out, 0x5A, SIZE_OF_PUB_KEY_BIN);
+}
+
+void sign_tx(uint8_t *dst, __attribute__((unused)) const accountPath_t *path,
+             __attribute__((unused)) const uint8_t *tx, __attribute__((unused)) uint16_t length) {
+    memset(dst, 0xA5, SIZEOF_SIGNATURE);
+}
+
+void sign_stream_start(__attribute__((unused)) signStreamOwner_t owner, __attribute__((unused)) const accountPath_t *path,
+                       __attribute__((unused)) const void *request, __attribute__((unused)) uint16_t length) {
+}
+
+void sign_stream_update(__attribute__((unused)) signStreamOwner_t owner, __attribute__((unused)) const uint8_t *data,
+                        __attribute__((unused)) uint16_t length) {
+}
+
+void sign_stream_finish(__attribute__((unused)) signStreamOwner_t owner, uint8_t *dst,
+                        __attribute__((unused)) const accountPath_t *path) {
+    memset(dst, 0xA5, SIZEOF_SIGNATURE);
+}
+
+static uint64_t now(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+typedef uint32_t create_fn_t(const accountPath_t *path);
+typedef uint32_t size_fn_t(void);
+
+// the result is kept so that the calls are not optimized away
+static volatile uint32_t sink;
+
+static uint64_t best_average(create_fn_t *create, size_fn_t *size, const accountPath_t *path) {
+    uint64_t best = UINT64_MAX;
+    for (int run = 0; run < RUNS; run++) {
+        uint64_t start = now();
+        for (int i = 0; i < ITERATIONS; i++) {
+            sink = create ? create(path) : size();
+        }
+        uint64_t average = (now() - start) / ITERATIONS;
+        if (average < best) {
+            best = average;
+        }
+    }
+    return best;
+}
+
+static void fill_key(unsigned char *key, uint8_t seed) {
+    key[0] = 0;
+    key[1] = NETTYPE_MAIN | KEYTYPE_ED25519;
+    memset(&key[2], seed, SIZEOF_B58_KEY - 2);
+}
+
+// The transactions carry realistic values: amounts of a few HNT in bones,
+// fees in DC and nonces in the thousands.
+static void fill_contexts(void) {
+    paymentContext_t *payment = &global.paymentContext;
+    payment->amount = 250000000;
+    payment->fee = 35000;
+    payment->nonce = 1042;
+    payment->memo = 0x0123456789ABCDEF;
+    fill_key(payment->payee, 1);
+
+    burnContext_t *burn = &global.burnContext;
+    burn->amount = 100000000;
+    burn->fee = 35000;
+    burn->nonce = 1043;
+    burn->memo = 42;
+    fill_key(burn->payee, 2);
+
+    createHtlcContext_t *htlc = &global.createHtlcContext;
+    htlc->amount = 500000000;
+    htlc->fee = 35000;
+    htlc->nonce = 1044;
+    htlc->timelock = 1250000;
+    fill_key(htlc->payee, 3);
+    fill_key(htlc->address, 4);
+    memset(htlc->hashlock, 0x33, sizeof(htlc->hashlock));
+
+    redeemHtlcContext_t *redeem = &global.redeemHtlcContext;
+    redeem->fee = 35000;
+    fill_key(redeem->address, 4);
+    redeem->preimage_len = 32;
+    memset(redeem->preimage, 0x44, sizeof(redeem->preimage));
+
+    updateGatewayOuiContext_t *gateway = &global.updateGatewayOuiContext;
+    gateway->oui = 7;
+    gateway->nonce = 3;
+    gateway->fee = 35000;
+    fill_key(gateway->gateway, 5);
+}
+
+int main() {
+    static const struct {
+        const char *name;
+        create_fn_t *create;
+        size_fn_t *size;
+    } txns[] = {
+            {"payment_v2", create_helium_pay_txn, size_helium_pay_txn},
+            {"token_burn_v1", create_helium_burn_txn, size_helium_burn_txn},
+            {"create_htlc_v1", create_helium_create_htlc_txn, size_helium_create_htlc_txn},
+            {"redeem_htlc_v1", create_helium_redeem_htlc_txn, size_helium_redeem_htlc_txn},
+            {"update_gateway_oui_v1", create_helium_update_gateway_oui_txn, size_helium_update_gateway_oui_txn},
+    };
+    accountPath_t path = {0};
+
+    fill_contexts();
+#ifdef TXN_ENCODE_GENERIC
+    printf("nanopb generic emitters\n");
+#else
+    printf("txn_encode emitters\n");
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    printf("%-24s %12s %12s\n", "transaction", "create (cyc)", "size (cyc)");
+#else
+    printf("%-24s %12s %12s\n", "transaction", "create (ns)", "size (ns)");
+#endif
+    for (size_t i = 0; i < sizeof(txns) / sizeof(txns[0]); i++) {
+        uint64_t create = best_average(txns[i].create, NULL, &path);
+        uint64_t size = best_average(NULL, txns[i].size, &path);
+        printf("%-24s %12llu %12llu\n", txns[i].name, (unsigned long long) create, (unsigned long long) size);
+    }
+    return 0;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// The transaction builders only reach the crypto API through sign_tx and
+// get_pubkey_bytes, which the tests replace.
@@ -0,0 +1,12 @@
+#pragma once
+
+// Just enough of the BOLOS SDK for the transaction builders in src/txns to
+// compile on the host. The tests provide the definitions.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define IO_APDU_BUFFER_SIZE 260
+
+extern unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
@@ -0,0 +1,110 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <cmocka.h>
+
+#include "../../src/address_book.h"
+
+static unsigned int writes;
+
+static void ram_write(void *dst, const void *src, size_t len) {
+    writes++;
+    memmove(dst, src, len);
+}
+
+static addressBookEntry_t make_entry(uint8_t id, const char *label) {
+    addressBookEntry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.key[1] = 1;
+    entry.key[2] = id;
+    entry.key[33] = id ^ 0x5A;
+    strncpy(entry.label, label, ADDRESS_BOOK_LABEL_LEN - 1);
+    return entry;
+}
+
+static void test_address_book_keeps_keys_sorted(void **state) {
+    static addressBook_t book;
+    uint8_t ids[] = {42, 7, 200, 13, 99};
+    memset(&book, 0, sizeof(book));
+    for (uint8_t i = 0; i < sizeof(ids); i++) {
+        addressBookEntry_t entry = make_entry(ids[i], "exchange");
+        assert(address_book_add(&book, &entry, ram_write));
+    }
+    assert(book.count == sizeof(ids));
+    for (uint8_t i = 1; i < book.count; i++) {
+        assert(memcmp(book.entries[i - 1].key, book.entries[i].key, ADDRESS_BOOK_KEY_LEN) < 0);
+    }
+    for (uint8_t i = 0; i < sizeof(ids); i++) {
+        addressBookEntry_t entry = make_entry(ids[i], "");
+        int found = address_book_find(&book, entry.key);
+        assert(found >= 0);
+        assert(book.entries[found].key[2] == ids[i]);
+    }
+    addressBookEntry_t missing = make_entry(8, "");
+    assert(address_book_find(&book, missing.key) == -1);
+}
+
+static void test_address_book_relabels_known_key(void **state) {
+    static addressBook_t book;
+    memset(&book, 0, sizeof(book));
+    addressBookEntry_t entry = make_entry(5, "old");
+    assert(address_book_add(&book, &entry, ram_write));
+    entry = make_entry(5, "treasury");
+    assert(address_book_add(&book, &entry, ram_write));
+    assert(book.count == 1);
+    assert(strcmp(book.entries[0].label, "treasury") == 0);
+}
+
+static void test_address_book_full(void **state) {
+    static addressBook_t book;
+    memset(&book, 0, sizeof(book));
+    for (uint8_t i = 0; i < ADDRESS_BOOK_CAPACITY; i++) {
+        addressBookEntry_t entry = make_entry(ADDRESS_BOOK_CAPACITY - i, "payout");
+        assert(address_book_add(&book, &entry, ram_write));
+    }
+    addressBookEntry_t extra = make_entry(ADDRESS_BOOK_CAPACITY + 1, "extra");
+    assert(!address_book_add(&book, &extra, ram_write));
+    assert(book.count == ADDRESS_BOOK_CAPACITY);
+    assert(address_book_find(&book, extra.key) == -1);
+}
+
+static void test_address_book_remove(void **state) {
+    static addressBook_t book;
+    memset(&book, 0, sizeof(book));
+    for (uint8_t i = 1; i <= 4; i++) {
+        addressBookEntry_t entry = make_entry(i, "payout");
+        assert(address_book_add(&book, &entry, ram_write));
+    }
+    addressBookEntry_t second = make_entry(2, "");
+    assert(address_book_remove(&book, second.key, ram_write));
+    assert(book.count == 3);
+    assert(address_book_find(&book, second.key) == -1);
+    assert(book.entries[0].key[2] == 1);
+    assert(book.entries[1].key[2] == 3);
+    assert(book.entries[2].key[2] == 4);
+    assert(!address_book_remove(&book, second.key, ram_write));
+}
+
+static void test_address_book_ignores_corrupt_count(void **state) {
+    static addressBook_t book;
+    memset(&book, 0, sizeof(book));
+    book.count = 0xFF;
+    addressBookEntry_t entry = make_entry(1, "");
+    assert(address_book_find(&book, entry.key) == -1);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_address_book_keeps_keys_sorted),
+            cmocka_unit_test(test_address_book_relabels_known_key),
+            cmocka_unit_test(test_address_book_full),
+            cmocka_unit_test(test_address_book_remove),
+            cmocka_unit_test(test_address_book_ignores_corrupt_count)
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
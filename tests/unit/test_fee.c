@@ -0,0 +1,52 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <cmocka.h>
+
+#include "../../src/fee.h"
+
+static uint32_t txn_size;
+
+static uint32_t fake_size(void) {
+    return txn_size;
+}
+
+static void test_fee_for_size(void **state) {
+    assert(!fee_set_params(5000, 0));
+    assert(!fee_params_set());
+    assert(fee_set_params(5000, 24));
+    assert(fee_params_set());
+    assert(fee_for_size(0) == 0);
+    assert(fee_for_size(1) == 5000);
+    assert(fee_for_size(24) == 5000);
+    assert(fee_for_size(25) == 10000);
+    assert(fee_for_size(180) == 8 * 5000);
+    // a rejected update keeps the previous parameters
+    assert(!fee_set_params(1, 0));
+    assert(fee_for_size(25) == 10000);
+}
+
+static void test_fee_fill(void **state) {
+    assert(fee_set_params(5000, 24));
+    uint64_t fee = 0;
+    txn_size = 100;
+    fee_fill(&fee, fake_size);
+    assert(fee == 5 * 5000);
+    // fees set by the host are kept
+    fee = 35000;
+    fee_fill(&fee, fake_size);
+    assert(fee == 35000);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_fee_for_size),
+            cmocka_unit_test(test_fee_fill)
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
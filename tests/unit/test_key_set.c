@@ -0,0 +1,122 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <cmocka.h>
+
+#include "../../src/key_set.h"
+
+static void make_key(uint8_t id, uint8_t *key) {
+    memset(key, 0, KEY_SET_KEY_LEN);
+    key[0] = 1;
+    // keys sharing their first byte share their first slot
+    key[1] = id % 4;
+    key[2] = id;
+    key[32] = id ^ 0x5A;
+}
+
+static bool found(const keySet_t *set, uint8_t i) {
+    return set->found[i / 8] & (1 << (i % 8));
+}
+
+static void test_key_set_matches_candidates(void **state) {
+    keySet_t set;
+    uint8_t key[KEY_SET_KEY_LEN];
+    key_set_reset(&set);
+    for (uint8_t id = 0; id < 10; id++) {
+        make_key(id, key);
+        assert(key_set_add(&set, key));
+    }
+    assert(set.count == 10);
+
+    make_key(6, key);
+    assert(key_set_match(&set, key));
+    make_key(9, key);
+    assert(key_set_match(&set, key));
+    make_key(77, key);
+    assert(key_set_match(&set, key) == false);
+
+    for (uint8_t i = 0; i < 10; i++) {
+        assert(found(&set, i) == (i == 6 || i == 9));
+    }
+}
+
+static void test_key_set_checks_key_type(void **state) {
+    keySet_t set;
+    uint8_t key[KEY_SET_KEY_LEN];
+    key_set_reset(&set);
+    make_key(3, key);
+    assert(key_set_add(&set, key));
+
+    key[0] = 0x11;
+    assert(key_set_match(&set, key) == false);
+    assert(found(&set, 0) == false);
+}
+
+static void test_key_set_compares_whole_keys(void **state) {
+    keySet_t set;
+    uint8_t key[KEY_SET_KEY_LEN];
+    key_set_reset(&set);
+    make_key(3, key);
+    assert(key_set_add(&set, key));
+
+    // the same key type and first 7 bytes of public key, then different
+    key[8] ^= 0x01;
+    assert(key_set_match(&set, key) == false);
+    key[8] ^= 0x01;
+    key[KEY_SET_KEY_LEN - 1] ^= 0x80;
+    assert(key_set_match(&set, key) == false);
+    assert(found(&set, 0) == false);
+}
+
+static void test_key_set_marks_duplicates(void **state) {
+    keySet_t set;
+    uint8_t key[KEY_SET_KEY_LEN];
+    key_set_reset(&set);
+    make_key(5, key);
+    assert(key_set_add(&set, key));
+    make_key(1, key);
+    assert(key_set_add(&set, key));
+    make_key(5, key);
+    assert(key_set_add(&set, key));
+
+    assert(key_set_match(&set, key));
+    assert(found(&set, 0) && !found(&set, 1) && found(&set, 2));
+}
+
+static void test_key_set_full(void **state) {
+    keySet_t set;
+    uint8_t key[KEY_SET_KEY_LEN];
+    key_set_reset(&set);
+    for (uint8_t id = 0; id < KEY_SET_CAPACITY; id++) {
+        make_key(id, key);
+        assert(key_set_add(&set, key));
+    }
+    make_key(KEY_SET_CAPACITY, key);
+    assert(key_set_add(&set, key) == false);
+
+    // every candidate can still be found, however long the probe chains
+    for (uint8_t id = 0; id < KEY_SET_CAPACITY; id++) {
+        make_key(id, key);
+        assert(key_set_match(&set, key));
+    }
+    for (uint8_t i = 0; i < sizeof(set.found); i++) {
+        assert(set.found[i] == 0xFF);
+    }
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_key_set_matches_candidates),
+            cmocka_unit_test(test_key_set_checks_key_type),
+            cmocka_unit_test(test_key_set_compares_whole_keys),
+            cmocka_unit_test(test_key_set_marks_duplicates),
+            cmocka_unit_test(test_key_set_full)
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
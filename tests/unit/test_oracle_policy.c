@@ -0,0 +1,133 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <cmocka.h>
+
+#include "../../src/oracle_policy.h"
+
+static void ram_write(void *dst, const void *src, size_t len) {
+    memmove(dst, src, len);
+}
+
+// make_policy enables a policy of a 5% change at most from a price of
+// 100000000, 10 to 100 blocks apart from height 1000, for 3 reports.
+static void make_policy(oraclePolicy_t *stored) {
+    oraclePolicy_t policy;
+    memset(&policy, 0, sizeof(policy));
+    memset(stored, 0, sizeof(*stored));
+    policy.max_delta_bps = 500;
+    policy.min_blocks = 10;
+    policy.max_blocks = 100;
+    policy.max_reports = 3;
+    policy.approved_price = 100000000;
+    policy.last_height = 1000;
+    policy.last_price = 100000000;
+    assert(oracle_policy_valid(&policy));
+    oracle_policy_set(stored, &policy, ram_write);
+}
+
+static void test_oracle_policy_valid(void **state) {
+    oraclePolicy_t policy;
+    memset(&policy, 0, sizeof(policy));
+    policy.max_delta_bps = ORACLE_POLICY_DELTA_BPS_MAX;
+    policy.min_blocks = 1;
+    policy.max_blocks = 1;
+    policy.max_reports = 1;
+    policy.approved_price = 1;
+    assert(oracle_policy_valid(&policy));
+    policy.max_delta_bps = ORACLE_POLICY_DELTA_BPS_MAX + 1;
+    assert(!oracle_policy_valid(&policy));
+    policy.max_delta_bps = 0;
+    policy.min_blocks = 0;
+    assert(!oracle_policy_valid(&policy));
+    policy.min_blocks = 2;
+    assert(!oracle_policy_valid(&policy));
+    policy.min_blocks = 1;
+    policy.max_reports = 0;
+    assert(!oracle_policy_valid(&policy));
+    policy.max_reports = 1;
+    policy.approved_price = 0;
+    assert(!oracle_policy_valid(&policy));
+}
+
+static void test_oracle_policy_heights(void **state) {
+    oraclePolicy_t policy;
+    make_policy(&policy);
+    assert(policy.enabled == 1);
+    // reports are at least min_blocks apart, and never go back
+    assert(!oracle_policy_allows(&policy, 100000000, 1000));
+    assert(!oracle_policy_allows(&policy, 100000000, 1009));
+    assert(!oracle_policy_allows(&policy, 100000000, 999));
+    assert(oracle_policy_allows(&policy, 100000000, 1010));
+    oracle_policy_record(&policy, 100000000, 1010, ram_write);
+    assert(policy.last_height == 1010 && policy.signed_count == 1);
+    assert(!oracle_policy_allows(&policy, 100000000, 1010));
+    assert(!oracle_policy_allows(&policy, 100000000, 1019));
+    // nor skip more than max_blocks ahead
+    assert(oracle_policy_allows(&policy, 100000000, 1110));
+    assert(!oracle_policy_allows(&policy, 100000000, 1111));
+    assert(!oracle_policy_allows(&policy, 100000000, UINT64_MAX));
+}
+
+static void test_oracle_policy_reports(void **state) {
+    oraclePolicy_t policy;
+    make_policy(&policy);
+    oracle_policy_record(&policy, 100000000, 1010, ram_write);
+    oracle_policy_record(&policy, 100000000, 1020, ram_write);
+    assert(oracle_policy_allows(&policy, 100000000, 1030));
+    oracle_policy_record(&policy, 100000000, 1030, ram_write);
+    // max_reports are signed, then the policy must be approved again
+    assert(!oracle_policy_allows(&policy, 100000000, 1040));
+    oraclePolicy_t renewed = policy;
+    renewed.last_height = 1030;
+    oracle_policy_set(&policy, &renewed, ram_write);
+    assert(policy.signed_count == 0);
+    assert(oracle_policy_allows(&policy, 100000000, 1040));
+}
+
+static void test_oracle_policy_prices(void **state) {
+    oraclePolicy_t policy;
+    make_policy(&policy);
+    assert(oracle_policy_allows(&policy, 105000000, 1010));
+    assert(oracle_policy_allows(&policy, 95000000, 1010));
+    assert(!oracle_policy_allows(&policy, 105000001, 1010));
+    assert(!oracle_policy_allows(&policy, 94999999, 1010));
+    // the bound stays on the approved price, so that the price cannot walk
+    // away from it one report at a time
+    oracle_policy_record(&policy, 105000000, 1010, ram_write);
+    assert(oracle_policy_allows(&policy, 105000000, 1020));
+    assert(!oracle_policy_allows(&policy, 105000001, 1020));
+    assert(!oracle_policy_allows(&policy, 110250000, 1020));
+
+    // large prices do not overflow the bound
+    policy.approved_price = UINT64_MAX;
+    policy.max_delta_bps = ORACLE_POLICY_DELTA_BPS_MAX;
+    assert(oracle_policy_allows(&policy, 0, 1020));
+    assert(oracle_policy_allows(&policy, UINT64_MAX, 1020));
+}
+
+static void test_oracle_policy_disable(void **state) {
+    oraclePolicy_t policy;
+    make_policy(&policy);
+    oracle_policy_disable(&policy, ram_write);
+    assert(!oracle_policy_allows(&policy, 100000000, 1010));
+    // an NVM area never written holds no policy
+    memset(&policy, 0xFF, sizeof(policy));
+    assert(!oracle_policy_allows(&policy, 100000000, 1010));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_oracle_policy_valid),
+            cmocka_unit_test(test_oracle_policy_heights),
+            cmocka_unit_test(test_oracle_policy_prices),
+            cmocka_unit_test(test_oracle_policy_reports),
+            cmocka_unit_test(test_oracle_policy_disable)
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,61 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <cmocka.h>
+
+#include "../../src/response.h"
+
+static void test_response_chunks(void **state) {
+    uint8_t data[600];
+    uint8_t out[600];
+    uint8_t chunk[RESPONSE_CHUNK_SIZE];
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 13);
+    }
+    response_reset();
+    assert(response_append(data, 300));
+    assert(response_append(&data[300], 200));
+    assert(response_pending() == 500);
+
+    uint16_t len = response_next(chunk);
+    assert(len == RESPONSE_CHUNK_SIZE);
+    memcpy(out, chunk, len);
+    assert(response_pending() == 500 - RESPONSE_CHUNK_SIZE);
+
+    len = response_next(chunk);
+    assert(len == 500 - RESPONSE_CHUNK_SIZE);
+    memcpy(&out[RESPONSE_CHUNK_SIZE], chunk, len);
+    assert(response_pending() == 0);
+    assert(memcmp(out, data, 500) == 0);
+
+    // nothing left to send
+    assert(response_next(chunk) == 0);
+}
+
+static void test_response_is_bounded(void **state) {
+    uint8_t data[RESPONSE_CAPACITY + 1];
+    memset(data, 0xAA, sizeof(data));
+    response_reset();
+    assert(!response_append(data, RESPONSE_CAPACITY + 1));
+    assert(response_pending() == 0);
+    assert(response_append(data, RESPONSE_CAPACITY - 1));
+    assert(!response_append(data, 2));
+    assert(response_append(data, 1));
+    assert(response_pending() == RESPONSE_CAPACITY);
+
+    response_reset();
+    assert(response_pending() == 0);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_response_chunks),
+            cmocka_unit_test(test_response_is_bounded)
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,93 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <cmocka.h>
+
+#include "../../src/review_summary.h"
+
+#define ADDRESS "13M8dUbxymE3xtiAXszRkGMmezMhBS8Li7wEsMojLdb4Sdxc4wc"
+
+static void test_review_summary_joins_parts(void **state) {
+    uint8_t buffer[55];
+    reviewSummary_t summary;
+    review_summary_init(&summary, buffer, sizeof(buffer));
+    review_summary_add(&summary, "Pay HNT", "1.5");
+    review_summary_add(&summary, "To", "Cold (trusted)");
+    review_summary_add(&summary, "Fee", "35000");
+
+    assert(review_summary_fits(&summary));
+    assert(strcmp((char *)buffer, "Pay HNT 1.5, To Cold (trusted), Fee 35000") == 0);
+    assert(summary.len == strlen((char *)buffer));
+}
+
+static void test_review_summary_keeps_addresses_whole(void **state) {
+    uint8_t buffer[55];
+    reviewSummary_t summary;
+    review_summary_init(&summary, buffer, sizeof(buffer));
+    // the ends of an address can be ground to match, so it is never cut
+    review_summary_add(&summary, "To", ADDRESS);
+
+    assert(review_summary_fits(&summary));
+    assert(strcmp((char *)buffer, "To " ADDRESS) == 0);
+
+    // and a summary it does not fit in is not shown
+    review_summary_init(&summary, buffer, sizeof(buffer));
+    review_summary_add(&summary, "Pay HNT", "1.5");
+    review_summary_add(&summary, "To", ADDRESS);
+    assert(review_summary_fits(&summary) == false);
+}
+
+static void test_review_summary_holds_several_addresses(void **state) {
+    uint8_t buffer[364];
+    reviewSummary_t summary;
+    review_summary_init(&summary, buffer, sizeof(buffer));
+    // a validator transfer names two owners and two validators
+    review_summary_add(&summary, "Transfer HNT", "10000");
+    review_summary_add(&summary, "For HNT", "0");
+    review_summary_add(&summary, "Old Owner", ADDRESS);
+    review_summary_add(&summary, "New Owner", ADDRESS);
+    review_summary_add(&summary, "Old Address", ADDRESS);
+    review_summary_add(&summary, "New Address", ADDRESS);
+    review_summary_add(&summary, "Fee", "55000");
+    review_summary_add(&summary, "As", "Both Owners");
+
+    assert(review_summary_fits(&summary));
+    assert(summary.len > UINT8_MAX);
+    assert(summary.len == strlen((char *)buffer));
+}
+
+static void test_review_summary_overflow(void **state) {
+    uint8_t buffer[16];
+    reviewSummary_t summary;
+    review_summary_init(&summary, buffer, sizeof(buffer));
+    review_summary_add(&summary, "Pay HNT", "1.5");
+    assert(review_summary_fits(&summary));
+    review_summary_add(&summary, "Fee", "35000");
+
+    assert(review_summary_fits(&summary) == false);
+    // what fit stays terminated, though it must not be shown
+    assert(strlen((char *)buffer) < sizeof(buffer));
+
+    // exactly filling the buffer, NUL included, fits
+    review_summary_init(&summary, buffer, 4);
+    review_summary_add(&summary, "", "abc");
+    assert(review_summary_fits(&summary));
+    review_summary_add(&summary, "", "");
+    assert(review_summary_fits(&summary) == false);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_review_summary_joins_parts),
+            cmocka_unit_test(test_review_summary_keeps_addresses_whole),
+            cmocka_unit_test(test_review_summary_holds_several_addresses),
+            cmocka_unit_test(test_review_summary_overflow)
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
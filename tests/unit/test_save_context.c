@@ -20,7 +20,7 @@ static void test_save_payment_context(void **state) {
     save_payment_context(3, 0, payment_buffer, 66, &ctx);
     assert(ctx.amount == 8765432);
     assert(ctx.fee == 35000);
-    assert(ctx.account_index == 3);
+    assert(ctx.path.account == 3);
     assert(ctx.memo == 1234);
     for (uint8_t i = 0; i < 34; i++) {
         assert(ctx.payee[i] == payee[i]);
@@ -37,7 +37,7 @@ static void test_save_burn_context(void **state) {
     save_burn_context(8, 0, burn_buffer, 66, &ctx);
     assert(ctx.amount == 9993121);
     assert(ctx.fee == 342443);
-    assert(ctx.account_index == 8);
+    assert(ctx.path.account == 8);
     assert(ctx.memo == 13234);
     for (uint8_t i = 0; i < 34; i++) {
         assert(ctx.payee[i] == payee[i]);
@@ -54,7 +54,7 @@ static void test_save_sec_transfer_context(void **state) {
     save_transfer_sec_context(8, 0, transfer_sec_buffer, 58, &ctx);
     assert(ctx.amount == 9219);
     assert(ctx.fee == 3424343);
-    assert(ctx.account_index == 8);
+    assert(ctx.path.account == 8);
     for (uint8_t i = 0; i < 34; i++) {
         assert(ctx.payee[i] == payee[i]);
     }
@@ -70,7 +70,7 @@ static void test_save_validator_stake_context(void **state) {
     save_stake_validator_context(8, 0, stake_validator_buffer, 50, &ctx);
     assert(ctx.stake == 9122219);
     assert(ctx.fee == 11234);
-    assert(ctx.account_index == 8);
+    assert(ctx.path.account == 8);
     for (uint8_t i = 0; i < 34; i++) {
         assert(ctx.address[i] == address[i]);
     }
@@ -86,7 +86,7 @@ static void test_save_validator_transfer_context(void **state) {
     assert(ctx.stake_amount == 9122219);
     assert(ctx.payment_amount == 11234);
     assert(ctx.fee == 9123219);
-    assert(ctx.account_index == 8);
+    assert(ctx.path.account == 8);
     for(uint8_t i=0; i<34; i++) {
         assert(ctx.new_owner[i] == new_owner[i]);
     }
@@ -101,6 +101,34 @@ static void test_save_validator_transfer_context(void **state) {
     }
 }
 
+static void test_save_validator_transfer_both_owners(void **state) {
+    transferValidatorContext_t ctx;
+    uint8_t request[160 + 24] = {0};
+    // old owner at 7'/0'/0', new owner at 9'/1'/2'
+    request[160] = 7;
+    request[172] = 9;
+    request[176] = 1;
+    request[180] = 2;
+
+    assert(save_transfer_validator_context(3, 0, request, 160, &ctx));
+    assert(ctx.both_owners == false);
+    assert(ctx.path.account == 3);
+
+    assert(save_transfer_validator_context(3, P2_TRANSFER_VALIDATOR_BOTH_OWNERS, request, 184, &ctx));
+    assert(ctx.both_owners);
+    assert(ctx.path.account == 7 && ctx.path.change == 0 && ctx.path.address == 0);
+    assert(ctx.new_owner_path.account == 9 && ctx.new_owner_path.change == 1 && ctx.new_owner_path.address == 2);
+
+    request[164] = 9;
+    assert(save_transfer_validator_context(3, P2_TRANSFER_VALIDATOR_BOTH_OWNERS, request, 168, &ctx));
+    assert(ctx.path.account == 7 && ctx.new_owner_path.account == 9);
+
+    // both paths are required, in the same form
+    assert(save_transfer_validator_context(3, P2_TRANSFER_VALIDATOR_BOTH_OWNERS, request, 160, &ctx) == false);
+    assert(save_transfer_validator_context(3, P2_TRANSFER_VALIDATOR_BOTH_OWNERS, request, 176, &ctx) == false);
+    assert(save_transfer_validator_context(3, P2_TRANSFER_VALIDATOR_BOTH_OWNERS, request, 169, &ctx) == false);
+}
+
 static void test_save_validator_unstake_context(void **state) {
     uint8_t address[] = {0, 1, 149, 222, 195, 16, 5, 249, 3, 234, 179, 175, 194, 131, 71, 143, 176, 224, 107, 71, 55,
                          65, 95, 63, 131, 224, 66, 211, 117, 253, 250, 87, 190, 42,};
@@ -113,20 +141,466 @@ static void test_save_validator_unstake_context(void **state) {
     assert(ctx.stake_amount == 912114299);
     assert(ctx.stake_release_height == 9103312219);
     assert(ctx.fee == 771234);
-    assert(ctx.account_index == 8);
+    assert(ctx.path.account == 8);
     for (uint8_t i = 0; i < 34; i++) {
         assert(ctx.address[i] == address[i]);
     }
 }
 
+static void test_save_address_book_context(void **state) {
+    uint8_t key[] = {0, 1, 149, 222, 195, 16, 5, 249, 3, 234, 179, 175, 194, 131, 71, 143, 176, 224, 107, 71, 55, 65,
+                     95, 63, 131, 224, 66, 211, 117, 253, 250, 87, 190, 42,};
+    addressBookContext_t ctx;
+    uint8_t address_book_buffer[] = {0, 1, 149, 222, 195, 16, 5, 249, 3, 234, 179, 175, 194, 131, 71, 143, 176, 224,
+                                     107, 71, 55, 65, 95, 63, 131, 224, 66, 211, 117, 253, 250, 87, 190, 42, 't', 'r',
+                                     'e', 'a', 's', 'u', 'r', 'y',};
+    save_address_book_context(0, 0, address_book_buffer, 42, &ctx);
+    assert(ctx.operation == 0);
+    assert(strcmp(ctx.entry.label, "treasury") == 0);
+    for (uint8_t i = 0; i < 34; i++) {
+        assert(ctx.entry.key[i] == key[i]);
+    }
+    // removals carry no label
+    save_address_book_context(1, 0, address_book_buffer, 34, &ctx);
+    assert(ctx.operation == 1);
+    assert(ctx.entry.label[0] == '\0');
+}
+
+static void test_save_batch_context(void **state) {
+    batchContext_t ctx;
+    uint8_t batch_buffer[SIZEOF_BATCH_CONTEXT] = {1, 10, 0, 0, 0, 0, 0, 0, 0, 44, 1, 0, 228, 11, 84, 2, 0, 0, 0, 184,
+                                                  136, 0, 0, 0, 0, 0, 0,};
+    batch_buffer[27] = 0xAB;
+    batch_buffer[SIZEOF_BATCH_CONTEXT - 1] = 0xCD;
+    assert(save_batch_context(0, 4, batch_buffer, SIZEOF_BATCH_CONTEXT, &ctx));
+    assert(ctx.type == 1);
+    assert(ctx.path.account == 4);
+    assert(ctx.first_nonce == 10);
+    assert(ctx.count == 300);
+    assert(ctx.last_nonce == 309);
+    assert(ctx.total == 10000000000);
+    assert(ctx.fee == 35000);
+    assert(ctx.entries_digest[0] == 0xAB && ctx.entries_digest[BATCH_DIGEST_LEN - 1] == 0xCD);
+}
+
+static void test_save_batch_entry(void **state) {
+    uint8_t payee[] = {0, 1, 149, 222, 195, 16, 5, 249, 3, 234, 179, 175, 194, 131, 71, 143, 176, 224, 107, 71, 55, 65,
+                       95, 63, 131, 224, 66, 211, 117, 253, 250, 87, 190, 42,};
+    batchEntry_t entry;
+    uint8_t entry_buffer[] = {248, 191, 133, 0, 0, 0, 0, 0, 210, 4, 0, 0, 0, 0, 0, 0, 0, 1, 149, 222, 195, 16, 5, 249,
+                              3, 234, 179, 175, 194, 131, 71, 143, 176, 224, 107, 71, 55, 65, 95, 63, 131, 224, 66, 211,
+                              117, 253, 250, 87, 190, 42,};
+    save_batch_entry(entry_buffer, &entry);
+    assert(entry.amount == 8765432);
+    assert(entry.memo == 1234);
+    for (uint8_t i = 0; i < 34; i++) {
+        assert(entry.payee[i] == payee[i]);
+    }
+}
+
+static void test_save_payment_compact(void **state) {
+    paymentContext_t ctx;
+    uint8_t request[64] = {REQUEST_COMPACT_VERSION, REQUEST_HAS_MEMO | REQUEST_HAS_PATH,
+                           0xF8, 0xFF, 0x96, 0x04, // amount 8765432
+                           5,                      // nonce
+    };
+    uint8_t len = 7;
+    for (uint8_t i = 0; i < 33; i++) {
+        request[len++] = i + 1;
+    }
+    request[len++] = 0xD2; // memo 1234
+    request[len++] = 0x09;
+    request[len++] = 0xFF; // account 2^31 - 1
+    request[len++] = 0xFF;
+    request[len++] = 0xFF;
+    request[len++] = 0xFF;
+    request[len++] = 0x07;
+    request[len++] = 1; // change
+    request[len++] = 2; // address
+
+    assert(save_payment_context(3, P2_REQUEST_COMPACT, request, len, &ctx));
+    assert(ctx.amount == 8765432);
+    assert(ctx.nonce == 5);
+    assert(ctx.fee == 0);
+    assert(ctx.memo == 1234);
+    assert(ctx.payee[0] == 0 && ctx.payee[1] == 1 && ctx.payee[33] == 33);
+    assert(ctx.path.account == 0x7FFFFFFF && ctx.path.change == 1 && ctx.path.address == 2);
+
+    // every read is bounds-checked, and nothing may follow the request
+    for (uint8_t short_len = 0; short_len < len; short_len++) {
+        assert(save_payment_context(3, P2_REQUEST_COMPACT, request, short_len, &ctx) == false);
+    }
+    assert(save_payment_context(3, P2_REQUEST_COMPACT, request, len + 1, &ctx) == false);
+
+    // the account is P1 without a path
+    request[1] = REQUEST_HAS_MEMO;
+    assert(save_payment_context(3, P2_REQUEST_COMPACT, request, len - 7, &ctx));
+    assert(ctx.path.account == 3 && ctx.path.change == 0);
+
+    // unknown versions and fields are refused
+    request[1] = 0x40 | REQUEST_HAS_MEMO;
+    assert(save_payment_context(3, P2_REQUEST_COMPACT, request, len - 7, &ctx) == false);
+    request[1] = REQUEST_HAS_MEMO;
+    request[0] = 3;
+    assert(save_payment_context(3, P2_REQUEST_COMPACT, request, len - 7, &ctx) == false);
+}
+
+static void test_save_compact_varints(void **state) {
+    stakeValidatorContext_t ctx;
+    uint8_t request[2 + 10 + 33] = {REQUEST_COMPACT_VERSION, 0};
+
+    // the largest stake takes ten bytes
+    memset(&request[2], 0xFF, 9);
+    request[11] = 0x01;
+    assert(save_stake_validator_context(1, P2_REQUEST_COMPACT, request, sizeof(request), &ctx));
+    assert(ctx.stake == UINT64_MAX);
+
+    // a tenth byte above 1 overflows 64 bits
+    request[11] = 0x02;
+    assert(save_stake_validator_context(1, P2_REQUEST_COMPACT, request, sizeof(request), &ctx) == false);
+
+    // a path index must fit in 31 bits
+    uint8_t with_path[2 + 1 + 33 + 7] = {REQUEST_COMPACT_VERSION, REQUEST_HAS_PATH, 1};
+    with_path[36] = 0x80;
+    with_path[37] = 0x80;
+    with_path[38] = 0x80;
+    with_path[39] = 0x80;
+    with_path[40] = 0x08;
+    assert(save_stake_validator_context(1, P2_REQUEST_COMPACT, with_path, sizeof(with_path), &ctx) == false);
+    with_path[40] = 0x07;
+    assert(save_stake_validator_context(1, P2_REQUEST_COMPACT, with_path, sizeof(with_path), &ctx));
+    assert(ctx.path.account == 0x70000000);
+}
+
+static void test_save_transfer_validator_compact(void **state) {
+    transferValidatorContext_t ctx;
+    uint8_t request[2 + 2 + 4 * 33 + 3 + 3] = {REQUEST_COMPACT_VERSION, REQUEST_HAS_PATH | REQUEST_HAS_NEW_OWNER_PATH,
+                                              100, 0};
+    uint8_t len = 4 + 4 * 33;
+    request[len++] = 7;
+    request[len++] = 0;
+    request[len++] = 0;
+    request[len++] = 9;
+    request[len++] = 1;
+    request[len++] = 2;
+
+    assert(save_transfer_validator_context(3, P2_REQUEST_COMPACT, request, len, &ctx));
+    assert(ctx.stake_amount == 100 && ctx.payment_amount == 0);
+    assert(ctx.both_owners);
+    assert(ctx.path.account == 7);
+    assert(ctx.new_owner_path.account == 9 && ctx.new_owner_path.change == 1 && ctx.new_owner_path.address == 2);
+
+    // both owners need the path of the old one
+    request[1] = REQUEST_HAS_NEW_OWNER_PATH;
+    assert(save_transfer_validator_context(3, P2_REQUEST_COMPACT, request, len - 3, &ctx) == false);
+}
+
+static void test_save_routing_context(void **state) {
+    routingContext_t ctx;
+    uint8_t request[SIZEOF_ROUTING_REQUEST + 1 + 2 * SIZEOF_B58_KEY + 4] = {
+            7, 0, 0, 0,                    // oui
+            184, 136, 0, 0, 0, 0, 0, 0,    // fee 35000
+            5, 0, 0, 0, 0, 0, 0, 0,        // nonce
+            0, 0, 0, 0, 0, 0, 0, 0,        // staking fee
+            ROUTING_UPDATE_ROUTERS, 2,
+    };
+    for (uint8_t i = 0; i < 2 * SIZEOF_B58_KEY; i++) {
+        request[SIZEOF_ROUTING_REQUEST + 1 + i] = i;
+    }
+    request[sizeof(request) - 4] = 9; // account
+
+    assert(save_routing_context(0, 3, request, sizeof(request), &ctx));
+    assert(ctx.oui == 7);
+    assert(ctx.fee == 35000);
+    assert(ctx.nonce == 5);
+    assert(ctx.router_count == 2);
+    assert(ctx.routers[1][0] == SIZEOF_B58_KEY);
+    assert(ctx.path.account == 9);
+    // without the path, the account is P2
+    assert(save_routing_context(0, 3, request, sizeof(request) - 4, &ctx));
+    assert(ctx.path.account == 3);
+    // the keys must all be there, and there are 3 at most
+    assert(!save_routing_context(0, 3, request, sizeof(request) - 5, &ctx));
+    request[SIZEOF_ROUTING_REQUEST] = ROUTING_ROUTERS_MAX + 1;
+    assert(!save_routing_context(0, 3, request, sizeof(request), &ctx));
+
+    // a filter update has its index and length
+    request[28] = ROUTING_UPDATE_XOR;
+    memset(&request[SIZEOF_ROUTING_REQUEST], 0, 8);
+    request[SIZEOF_ROUTING_REQUEST] = 4;
+    request[SIZEOF_ROUTING_REQUEST + 5] = 0x90; // 102400
+    request[SIZEOF_ROUTING_REQUEST + 6] = 0x01;
+    assert(save_routing_context(0, 3, request, SIZEOF_ROUTING_REQUEST + 8, &ctx));
+    assert(ctx.xor_index == 4);
+    assert(ctx.filter_length == ROUTING_FILTER_MAX);
+    assert(ctx.filter_received == 0);
+    assert(!save_routing_context(0, 3, request, SIZEOF_ROUTING_REQUEST + 7, &ctx));
+
+    request[28] = ROUTING_REQUEST_SUBNET + 1;
+    assert(!save_routing_context(0, 3, request, SIZEOF_ROUTING_REQUEST + 8, &ctx));
+    assert(!save_routing_context(0, 3, request, SIZEOF_ROUTING_REQUEST - 1, &ctx));
+}
+
+static void test_save_state_channel_open_context(void **state) {
+    stateChannelOpenContext_t ctx;
+    uint8_t request[41 + 3 + 4] = {
+            160, 134, 1, 0, 0, 0, 0, 0,    // amount 100000
+            100, 0, 0, 0, 0, 0, 0, 0,      // expire within 100 blocks
+            7, 0, 0, 0, 0, 0, 0, 0,        // oui
+            5, 0, 0, 0, 0, 0, 0, 0,        // nonce
+            184, 136, 0, 0, 0, 0, 0, 0,    // fee 35000
+            3, 'i', 'd', 's',
+            2, 0, 0, 0,                    // account
+    };
+
+    assert(save_state_channel_open_context(6, 0, request, sizeof(request), &ctx));
+    assert(ctx.amount == 100000);
+    assert(ctx.expire_within == 100);
+    assert(ctx.oui == 7);
+    assert(ctx.nonce == 5);
+    assert(ctx.fee == 35000);
+    assert(ctx.id_len == 3 && memcmp(ctx.id, "ids", 3) == 0);
+    assert(ctx.path.account == 2);
+    // without the path, the account is P1
+    assert(save_state_channel_open_context(6, 0, request, sizeof(request) - 4, &ctx));
+    assert(ctx.path.account == 6);
+    // the id must all be there, and take 32 bytes at most
+    assert(!save_state_channel_open_context(6, 0, request, 43, &ctx));
+    request[40] = STATE_CHANNEL_ID_MAX + 1;
+    assert(!save_state_channel_open_context(6, 0, request, sizeof(request), &ctx));
+}
+
+static void test_save_batch_channel(void **state) {
+    batchContext_t ctx;
+    uint8_t batch_buffer[SIZEOF_BATCH_CHANNEL_CONTEXT] = {BATCH_TYPE_STATE_CHANNEL_OPEN, 10, 0, 0, 0, 0, 0, 0, 0, 2};
+    batch_buffer[SIZEOF_BATCH_CONTEXT] = 100;
+    assert(save_batch_context(0, 4, batch_buffer, sizeof(batch_buffer), &ctx));
+    assert(ctx.count == 2 && ctx.expire_within == 100 && ctx.path.account == 4);
+    // the blocks they expire within are required
+    assert(!save_batch_context(0, 4, batch_buffer, SIZEOF_BATCH_CONTEXT, &ctx));
+
+    batchEntry_t entry;
+    uint8_t entry_buffer[SIZEOF_BATCH_CHANNEL_ENTRY] = {7, 0, 0, 0, 0, 0, 0, 0, 160, 134, 1, 0, 0, 0, 0, 0, 2, 'i', 'd'};
+    save_batch_channel_entry(entry_buffer, &entry);
+    assert(entry.oui == 7);
+    assert(entry.amount == 100000);
+    assert(entry.id_len == 2 && memcmp(entry.id, "id", 2) == 0);
+}
+
+static void test_save_oui_context(void **state) {
+    ouiContext_t ctx;
+    uint16_t len = 28 + SIZEOF_B58_KEY;
+    uint8_t request[28 + 3 * SIZEOF_B58_KEY + 2 + 4 + 8] = {
+            7, 0, 0, 0, 0, 0, 0, 0,        // oui
+            0, 228, 11, 84, 2, 0, 0, 0,    // staking fee
+            184, 136, 0, 0, 0, 0, 0, 0,    // fee 35000
+            8, 0, 0, 0,                    // subnet size
+    };
+    request[28 + 1] = 1;                   // payer
+    request[len] = 2;
+    request[len + 1 + SIZEOF_B58_KEY + 1] = 3;
+    request[len + 1 + 2 * SIZEOF_B58_KEY] = 4;
+    memcpy(&request[len + 2 + 2 * SIZEOF_B58_KEY], "xorf", 4);
+    uint16_t end = len + 6 + 2 * SIZEOF_B58_KEY;
+    request[end] = 9;                      // owner account
+    request[end + 4] = 11;                 // payer account
+
+    assert(save_oui_context(5, 0, request, end + 4, &ctx));
+    assert(ctx.oui == 7);
+    assert(ctx.staking_fee == 10000000000);
+    assert(ctx.fee == 35000);
+    assert(ctx.requested_subnet_size == 8);
+    assert(ctx.payer[1] == 1);
+    assert(ctx.address_count == 2 && ctx.addresses[1][1] == 3);
+    assert(ctx.filter_len == 4 && memcmp(ctx.filter, "xorf", 4) == 0);
+    assert(!ctx.both_signers && ctx.path.account == 9);
+    assert(save_oui_context(5, 0, request, end, &ctx));
+    assert(ctx.path.account == 5);
+
+    assert(save_oui_context(5, P2_OUI_OWNER_AND_PAYER, request, end + 8, &ctx));
+    assert(ctx.both_signers);
+    assert(ctx.path.account == 9 && ctx.payer_path.account == 11);
+    // both paths are required, in the same form
+    assert(!save_oui_context(5, P2_OUI_OWNER_AND_PAYER, request, end, &ctx));
+    assert(!save_oui_context(5, P2_OUI_OWNER_AND_PAYER, request, end + 4, &ctx));
+
+    // the filter must all be there, and the routers are 3 at most
+    assert(!save_oui_context(5, 0, request, end - 1, &ctx));
+    request[len] = OUI_ADDRESSES_MAX + 1;
+    assert(!save_oui_context(5, 0, request, sizeof(request), &ctx));
+}
+
+static void test_save_oracle_contexts(void **state) {
+    oraclePolicyContext_t policy;
+    uint8_t request[SIZEOF_ORACLE_POLICY_REQUEST + 4] = {
+            244, 1, 0, 0,                  // 500 bps
+            10, 0, 0, 0,                   // 10 blocks apart
+            100, 0, 0, 0,                  // at most 100 blocks apart
+            24, 0, 0, 0,                   // 24 reports
+            232, 3, 0, 0, 0, 0, 0, 0,      // after block 1000
+            0, 225, 245, 5, 0, 0, 0, 0,    // price 100000000
+            6, 0, 0, 0,                    // account
+    };
+    assert(save_oracle_policy_context(0, 2, request, sizeof(request), &policy));
+    assert(policy.max_delta_bps == 500);
+    assert(policy.min_blocks == 10);
+    assert(policy.max_blocks == 100);
+    assert(policy.max_reports == 24);
+    assert(policy.reference_height == 1000);
+    assert(policy.reference_price == 100000000);
+    assert(policy.path.account == 6);
+    // without the path, the account is P2
+    assert(save_oracle_policy_context(0, 2, request, SIZEOF_ORACLE_POLICY_REQUEST, &policy));
+    assert(policy.path.account == 2);
+    assert(!save_oracle_policy_context(0, 2, request, SIZEOF_ORACLE_POLICY_REQUEST - 1, &policy));
+
+    // reports are price and height only
+    priceOracleContext_t report;
+    assert(save_price_oracle_context(0, 0, &request[16], SIZEOF_PRICE_ORACLE_REQUEST, &report));
+    assert(report.price == 1000 && report.block_height == 100000000);
+    assert(!save_price_oracle_context(0, 0, &request[16], SIZEOF_PRICE_ORACLE_REQUEST + 4, &report));
+}
+
+static void test_save_update_gateway_oui(void **state) {
+    updateGatewayOuiContext_t ctx;
+    uint8_t request[SIZEOF_UPDATE_GATEWAY_OUI_REQUEST + 8] = {
+            7, 0, 0, 0, 0, 0, 0, 0,        // oui
+            3, 0, 0, 0, 0, 0, 0, 0,        // gateway nonce
+            184, 136, 0, 0, 0, 0, 0, 0,    // fee 35000
+            0, 1, 2,
+    };
+    request[SIZEOF_UPDATE_GATEWAY_OUI_REQUEST] = 4;      // gateway owner
+    request[SIZEOF_UPDATE_GATEWAY_OUI_REQUEST + 4] = 5;  // OUI owner
+    assert(save_update_gateway_oui_context(1, 0, request, sizeof(request), &ctx));
+    assert(ctx.oui == 7 && ctx.nonce == 3 && ctx.fee == 35000);
+    assert(ctx.gateway[1] == 1 && ctx.gateway[2] == 2);
+    assert(ctx.path.account == 4 && ctx.oui_owner_path.account == 5);
+    // both paths are required
+    assert(!save_update_gateway_oui_context(1, 0, request, SIZEOF_UPDATE_GATEWAY_OUI_REQUEST, &ctx));
+    assert(!save_update_gateway_oui_context(1, 0, request, sizeof(request) - 4, &ctx));
+
+    batchContext_t batch;
+    uint8_t batch_buffer[SIZEOF_BATCH_GATEWAY_CONTEXT + 8] = {BATCH_TYPE_UPDATE_GATEWAY_OUI, 0, 0, 0, 0, 0, 0, 0, 0, 200};
+    batch_buffer[SIZEOF_BATCH_CONTEXT] = 9;
+    batch_buffer[SIZEOF_BATCH_GATEWAY_CONTEXT] = 4;
+    batch_buffer[SIZEOF_BATCH_GATEWAY_CONTEXT + 4] = 5;
+    assert(save_batch_context(0, 1, batch_buffer, sizeof(batch_buffer), &batch));
+    assert(batch.count == 200 && batch.oui == 9);
+    assert(batch.path.account == 4 && batch.oui_owner_path.account == 5);
+    assert(!save_batch_context(0, 1, batch_buffer, SIZEOF_BATCH_GATEWAY_CONTEXT, &batch));
+
+    batchEntry_t entry;
+    uint8_t entry_buffer[SIZEOF_BATCH_GATEWAY_ENTRY] = {0, 1, 2};
+    entry_buffer[SIZEOF_B58_KEY] = 3;
+    save_batch_gateway_entry(entry_buffer, &entry);
+    assert(entry.payee[1] == 1 && entry.payee[2] == 2);
+    assert(entry.nonce == 3 && entry.amount == 0);
+}
+
+static void test_save_htlc_contexts(void **state) {
+    createHtlcContext_t create;
+    uint8_t request[SIZEOF_CREATE_HTLC_REQUEST + 4] = {
+            0, 225, 245, 5, 0, 0, 0, 0,    // amount 100000000
+            184, 136, 0, 0, 0, 0, 0, 0,    // fee 35000
+            3, 0, 0, 0, 0, 0, 0, 0,        // nonce
+            64, 66, 15, 0, 0, 0, 0, 0,     // timelock 1000000
+            0, 1,
+    };
+    request[32 + SIZEOF_B58_KEY + 1] = 2;      // address
+    request[32 + 2 * SIZEOF_B58_KEY] = 3;      // hashlock
+    request[SIZEOF_CREATE_HTLC_REQUEST] = 6;   // account
+    assert(save_create_htlc_context(1, 0, request, sizeof(request), &create));
+    assert(create.amount == 100000000 && create.fee == 35000);
+    assert(create.nonce == 3 && create.timelock == 1000000);
+    assert(create.payee[1] == 1 && create.address[1] == 2 && create.hashlock[0] == 3);
+    assert(create.path.account == 6);
+    assert(save_create_htlc_context(1, 0, request, SIZEOF_CREATE_HTLC_REQUEST, &create));
+    assert(create.path.account == 1);
+    assert(!save_create_htlc_context(1, 0, request, SIZEOF_CREATE_HTLC_REQUEST - 1, &create));
+
+    // redeems end with the preimage, after its length
+    redeemHtlcContext_t redeem;
+    uint16_t len = 8 + SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN;
+    uint8_t redeem_request[8 + SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN + 1 + 3 + 4] = {
+            184, 136, 0, 0, 0, 0, 0, 0,    // fee 35000
+            0, 2,
+    };
+    redeem_request[8 + SIZEOF_B58_KEY] = 3;
+    redeem_request[len] = 3;
+    memcpy(&redeem_request[len + 1], "key", 3);
+    redeem_request[len + 4] = 7;
+    assert(save_redeem_htlc_context(1, 0, redeem_request, sizeof(redeem_request), &redeem));
+    assert(redeem.fee == 35000 && redeem.address[1] == 2 && redeem.hashlock[0] == 3);
+    assert(redeem.preimage_len == 3 && memcmp(redeem.preimage, "key", 3) == 0);
+    assert(redeem.path.account == 7);
+    assert(save_redeem_htlc_context(1, 0, redeem_request, len + 4, &redeem));
+    assert(redeem.path.account == 1);
+    // the preimage must all be there, and take 32 bytes at most
+    assert(!save_redeem_htlc_context(1, 0, redeem_request, len + 3, &redeem));
+    redeem_request[len] = HTLC_PREIMAGE_MAX + 1;
+    assert(!save_redeem_htlc_context(1, 0, redeem_request, sizeof(redeem_request), &redeem));
+
+    batchEntry_t entry;
+    uint8_t entry_buffer[SIZEOF_BATCH_CREATE_HTLC_ENTRY] = {5, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    entry_buffer[16 + SIZEOF_B58_KEY + 1] = 2;
+    entry_buffer[16 + 2 * SIZEOF_B58_KEY] = 3;
+    save_batch_create_htlc_entry(entry_buffer, &entry);
+    assert(entry.amount == 5 && entry.timelock == 9);
+    assert(entry.payee[1] == 1 && entry.address[1] == 2 && entry.hashlock[0] == 3);
+
+    uint8_t redeem_buffer[SIZEOF_BATCH_REDEEM_HTLC_ENTRY] = {0, 2};
+    redeem_buffer[SIZEOF_B58_KEY] = 3;
+    redeem_buffer[SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN] = 2;
+    redeem_buffer[SIZEOF_B58_KEY + HTLC_HASHLOCK_LEN + 1] = 'k';
+    save_batch_redeem_htlc_entry(redeem_buffer, &entry);
+    assert(entry.address[1] == 2 && entry.hashlock[0] == 3);
+    assert(entry.preimage_len == 2 && entry.preimage[0] == 'k' && entry.amount == 0);
+}
+
+static void test_save_account_path(void **state) {
+    accountPath_t path;
+    uint8_t request[] = {7, 7, 1, 0, 0, 0, 255, 255, 255, 127, 0, 0, 0, 0, 0, 0, 0, 128,};
+
+    // legacy requests take the account from P1 or P2
+    assert(save_account_path(5, request, 2, 2, &path));
+    assert(path.account == 5 && path.change == 0 && path.address == 0);
+
+    assert(save_account_path(5, request, 6, 2, &path));
+    assert(path.account == 1 && path.change == 0 && path.address == 0);
+
+    assert(save_account_path(5, request, 14, 2, &path));
+    assert(path.account == 1 && path.change == 0x7FFFFFFF && path.address == 0);
+
+    // indices must fit in 31 bits, and nothing else may follow the request
+    assert(save_account_path(5, &request[14], 4, 0, &path) == false);
+    assert(save_account_path(5, request, 18, 6, &path) == false);
+    assert(save_account_path(5, request, 3, 2, &path) == false);
+    assert(save_account_path(5, request, 10, 2, &path) == false);
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_save_payment_context),
             cmocka_unit_test(test_save_burn_context),
             cmocka_unit_test(test_save_validator_stake_context),
             cmocka_unit_test(test_save_validator_transfer_context),
+            cmocka_unit_test(test_save_validator_transfer_both_owners),
             cmocka_unit_test(test_save_validator_unstake_context),
-            cmocka_unit_test(test_save_sec_transfer_context)
+            cmocka_unit_test(test_save_sec_transfer_context),
+            cmocka_unit_test(test_save_address_book_context),
+            cmocka_unit_test(test_save_batch_context),
+            cmocka_unit_test(test_save_batch_entry),
+            cmocka_unit_test(test_save_routing_context),
+            cmocka_unit_test(test_save_state_channel_open_context),
+            cmocka_unit_test(test_save_batch_channel),
+            cmocka_unit_test(test_save_oui_context),
+            cmocka_unit_test(test_save_oracle_contexts),
+            cmocka_unit_test(test_save_update_gateway_oui),
+            cmocka_unit_test(test_save_htlc_contexts),
+            cmocka_unit_test(test_save_account_path),
+            cmocka_unit_test(test_save_payment_compact),
+            cmocka_unit_test(test_save_compact_varints),
+            cmocka_unit_test(test_save_transfer_validator_compact)
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
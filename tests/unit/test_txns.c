@@ -0,0 +1,828 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include <cmocka.h>
+
+#include "../../src/txns/helium.h"
+#include "../../src/save_context.h"
+#include "../../src/response.h"
+#include "pb_encode.h"
+#include "../../src/proto/blockchain_txn_create_htlc_v1.pb.h"
+#include "../../src/proto/blockchain_txn_oui_v1.pb.h"
+#include "../../src/proto/blockchain_txn_payment_v2.pb.h"
+#include "../../src/proto/blockchain_txn_price_oracle_v1.pb.h"
+#include "../../src/proto/blockchain_txn_redeem_htlc_v1.pb.h"
+#include "../../src/proto/blockchain_txn_routing_v1.pb.h"
+#include "../../src/proto/blockchain_txn_security_exchange_v1.pb.h"
+#include "../../src/proto/blockchain_txn_stake_validator_v1.pb.h"
+#include "../../src/proto/blockchain_txn_state_channel_open_v1.pb.h"
+#include "../../src/proto/blockchain_txn_token_burn_v1.pb.h"
+#include "../../src/proto/blockchain_txn_transfer_validator_stake_v1.pb.h"
+#include "../../src/proto/blockchain_txn_unstake_validator_v1.pb.h"
+#include "../../src/proto/blockchain_txn_update_gateway_oui_v1.pb.h"
+
+// Differential test of the hand-written encoders in src/txns: every round
+// fills a command context with random values, runs the device encoder and
+// compares its output with what pb_encode produces for the same transaction
+// from the generated descriptors in src/proto. The bytes passed to sign_tx,
+// the final signed transaction and the size its fee is based on are checked.
+//
+// The seed can be set with HELIUM_TEST_SEED to replay a failure.
+
+#define ROUNDS 5000
+
+// routing_v1 filters are drawn up to this length; the device takes 100 KB
+#define FILTER_MAX 2048
+#define REFERENCE_CAPACITY (FILTER_MAX + RESPONSE_CAPACITY)
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+commandContext global;
+
+static uint8_t signed_bytes[IO_APDU_BUFFER_SIZE];
+static uint16_t signed_length;
+
+// path_byte mixes every level of 'path' into the stub keys and signatures,
+// so that a builder passing on the wrong path is caught.
+static uint8_t path_byte(const accountPath_t *path) {
+    return (uint8_t) (path->account * 31 + path->change * 17 + path->address * 13);
+}
+
+void get_pubkey_bytes(const accountPath_t *path, uint8_t *out) {
+    for (uint8_t i = 0; i < SIZE_OF_PUB_KEY_BIN; i++) {
+        out[i] = (uint8_t) (path_byte(path) + i * 7 + 1);
+    }
+}
+
+void sign_tx(uint8_t *dst, const accountPath_t *path, const uint8_t *tx, uint16_t length) {
+    assert_true(length <= sizeof(signed_bytes));
+    memcpy(signed_bytes, tx, length);
+    signed_length = length;
+    for (uint8_t i = 0; i < SIZEOF_SIGNATURE; i++) {
+        dst[i] = (uint8_t) (path_byte(path) + i);
+    }
+}
+
+// The routing_v1 and oui_v1 builders stream what they sign; the stubs
+// collect it.
+static uint8_t streamed_bytes[REFERENCE_CAPACITY];
+static size_t streamed_length;
+static accountPath_t stream_path;
+
+void sign_stream_start(__attribute__((unused)) signStreamOwner_t owner, const accountPath_t *path,
+                       __attribute__((unused)) const void *request, __attribute__((unused)) uint16_t length) {
+    streamed_length = 0;
+    stream_path = *path;
+}
+
+void sign_stream_update(__attribute__((unused)) signStreamOwner_t owner, const uint8_t *data, uint16_t length) {
+    assert_true(streamed_length + length <= sizeof(streamed_bytes));
+    memcpy(&streamed_bytes[streamed_length], data, length);
+    streamed_length += length;
+}
+
+void sign_stream_finish(__attribute__((unused)) signStreamOwner_t owner, uint8_t *dst, const accountPath_t *path) {
+    assert_memory_equal(path, &stream_path, sizeof(*path));
+    for (uint8_t i = 0; i < SIZEOF_SIGNATURE; i++) {
+        dst[i] = (uint8_t) (path_byte(path) + i);
+    }
+}
+
+static uint64_t seed;
+static uint64_t rng_state;
+
+// xorshift64*, so that a seed replays the same rounds everywhere
+static uint64_t rand_u64(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+// rand_value draws the bit length first, so that zero and every varint
+// length are about as likely as each other.
+static uint64_t rand_value(void) {
+    uint8_t bits = rand_u64() % 65;
+    if (bits == 0) {
+        return 0;
+    }
+    return rand_u64() >> (64 - bits);
+}
+
+static accountPath_t rand_path(void) {
+    accountPath_t path;
+    path.account = rand_u64() & ACCOUNT_INDEX_MAX;
+    path.change = rand_u64() & ACCOUNT_INDEX_MAX;
+    path.address = rand_u64() & ACCOUNT_INDEX_MAX;
+    return path;
+}
+
+static void rand_key(unsigned char *key) {
+    key[0] = 0;
+    for (uint8_t i = 1; i < SIZEOF_B58_KEY; i++) {
+        key[i] = (unsigned char) rand_u64();
+    }
+}
+
+// device_key writes the key of 'path' as the encoders see it, in the
+// 34-byte format of the sign requests.
+static void device_key(const accountPath_t *path, unsigned char *key) {
+    key[0] = 0;
+    key[1] = NETTYPE_MAIN | KEYTYPE_ED25519;
+    get_pubkey_bytes(path, &key[2]);
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+} bytes_arg_t;
+
+static bool encode_bytes(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const bytes_arg_t *bytes = *arg;
+    return pb_encode_tag_for_field(stream, field) && pb_encode_string(stream, bytes->data, bytes->len);
+}
+
+static bool encode_payment(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    return pb_encode_tag_for_field(stream, field) && pb_encode_submessage(stream, helium_payment_fields, *arg);
+}
+
+static void set_bytes(pb_callback_t *callback, bytes_arg_t *arg, const uint8_t *data, size_t len) {
+    arg->data = data;
+    arg->len = len;
+    callback->funcs.encode = encode_bytes;
+    callback->arg = arg;
+}
+
+// signature is what the sign_tx stub produces for 'path'
+static void fake_signature(const accountPath_t *path, uint8_t *signature) {
+    for (uint8_t i = 0; i < SIZEOF_SIGNATURE; i++) {
+        signature[i] = (uint8_t) (path_byte(path) + i);
+    }
+}
+
+static void expect_encoding(const char *what, int round, const uint8_t *device, size_t device_len,
+                            const pb_msgdesc_t *fields, const void *msg) {
+    uint8_t reference[REFERENCE_CAPACITY];
+    pb_ostream_t ostream = pb_ostream_from_buffer(reference, sizeof(reference));
+    assert_true(pb_encode(&ostream, fields, msg));
+
+    if (device_len != ostream.bytes_written || memcmp(device, reference, device_len) != 0) {
+        fprintf(stderr, "%s differs from pb_encode in round %d (HELIUM_TEST_SEED=%llu)\n", what, round,
+                (unsigned long long) seed);
+    }
+    assert_int_equal(device_len, ostream.bytes_written);
+    assert_memory_equal(device, reference, device_len);
+}
+
+// expect_fee_size checks the size the fee is based on: 'msg' must hold the
+// signatures, and no fee.
+static void expect_fee_size(const char *what, int round, uint32_t device_size, const pb_msgdesc_t *fields,
+                            const void *msg) {
+    size_t size;
+    assert_true(pb_get_encoded_size(&size, fields, msg));
+    if (device_size != size) {
+        fprintf(stderr, "%s fee size differs from pb_encode in round %d (HELIUM_TEST_SEED=%llu)\n", what, round,
+                (unsigned long long) seed);
+    }
+    assert_int_equal(device_size, size);
+}
+
+static void test_payment_v2(void **state) {
+    paymentContext_t *ctx = &global.paymentContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->amount = rand_value();
+        ctx->nonce = rand_value();
+        ctx->fee = rand_value();
+        ctx->memo = rand_value();
+        rand_key(ctx->payee);
+        uint32_t length = create_helium_pay_txn(&path);
+
+        unsigned char payer[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t payer_arg, payee_arg, signature_arg;
+        device_key(&path, payer);
+        fake_signature(&path, signature);
+
+        helium_payment payment = helium_payment_init_zero;
+        set_bytes(&payment.payee, &payee_arg, &ctx->payee[1], SIZEOF_HELIUM_KEY);
+        payment.amount = ctx->amount;
+        payment.memo = ctx->memo;
+
+        helium_blockchain_txn_payment_v2 txn = helium_blockchain_txn_payment_v2_init_zero;
+        set_bytes(&txn.payer, &payer_arg, &payer[1], SIZEOF_HELIUM_KEY);
+        txn.payments.funcs.encode = encode_payment;
+        txn.payments.arg = &payment;
+        txn.fee = ctx->fee;
+        txn.nonce = ctx->nonce;
+        expect_encoding("unsigned payment_v2", round, signed_bytes, signed_length, helium_blockchain_txn_payment_v2_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("payment_v2", round, G_io_apdu_buffer, length, helium_blockchain_txn_payment_v2_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("payment_v2", round, size_helium_pay_txn(), helium_blockchain_txn_payment_v2_fields, &txn);
+    }
+}
+
+static void test_token_burn_v1(void **state) {
+    burnContext_t *ctx = &global.burnContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->amount = rand_value();
+        ctx->nonce = rand_value();
+        ctx->fee = rand_value();
+        ctx->memo = rand_value();
+        rand_key(ctx->payee);
+        uint32_t length = create_helium_burn_txn(&path);
+
+        unsigned char payer[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t payer_arg, payee_arg, signature_arg;
+        device_key(&path, payer);
+        fake_signature(&path, signature);
+
+        helium_blockchain_txn_token_burn_v1 txn = helium_blockchain_txn_token_burn_v1_init_zero;
+        set_bytes(&txn.payer, &payer_arg, &payer[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.payee, &payee_arg, &ctx->payee[1], SIZEOF_HELIUM_KEY);
+        txn.amount = ctx->amount;
+        txn.nonce = ctx->nonce;
+        txn.fee = ctx->fee;
+        txn.memo = ctx->memo;
+        expect_encoding("unsigned token_burn_v1", round, signed_bytes, signed_length, helium_blockchain_txn_token_burn_v1_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("token_burn_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_token_burn_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("token_burn_v1", round, size_helium_burn_txn(), helium_blockchain_txn_token_burn_v1_fields, &txn);
+    }
+}
+
+static void test_security_exchange_v1(void **state) {
+    transferSecContext_t *ctx = &global.transferSecContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->amount = rand_value();
+        ctx->nonce = rand_value();
+        ctx->fee = rand_value();
+        rand_key(ctx->payee);
+        uint32_t length = create_helium_transfer_sec(&path);
+
+        unsigned char payer[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t payer_arg, payee_arg, signature_arg;
+        device_key(&path, payer);
+        fake_signature(&path, signature);
+
+        helium_blockchain_txn_security_exchange_v1 txn = helium_blockchain_txn_security_exchange_v1_init_zero;
+        set_bytes(&txn.payer, &payer_arg, &payer[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.payee, &payee_arg, &ctx->payee[1], SIZEOF_HELIUM_KEY);
+        txn.amount = ctx->amount;
+        txn.fee = ctx->fee;
+        txn.nonce = ctx->nonce;
+        expect_encoding("unsigned security_exchange_v1", round, signed_bytes, signed_length, helium_blockchain_txn_security_exchange_v1_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("security_exchange_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_security_exchange_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("security_exchange_v1", round, size_helium_transfer_sec(), helium_blockchain_txn_security_exchange_v1_fields, &txn);
+    }
+}
+
+static void test_stake_validator_v1(void **state) {
+    stakeValidatorContext_t *ctx = &global.stakeValidatorContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->stake = rand_value();
+        ctx->fee = rand_value();
+        rand_key(ctx->address);
+        uint32_t length = create_helium_stake_txn(&path);
+
+        unsigned char owner[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t address_arg, owner_arg, signature_arg;
+        device_key(&path, owner);
+        fake_signature(&path, signature);
+
+        helium_blockchain_txn_stake_validator_v1 txn = helium_blockchain_txn_stake_validator_v1_init_zero;
+        set_bytes(&txn.address, &address_arg, &ctx->address[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.owner, &owner_arg, &owner[1], SIZEOF_HELIUM_KEY);
+        txn.stake = ctx->stake;
+        txn.fee = ctx->fee;
+        expect_encoding("unsigned stake_validator_v1", round, signed_bytes, signed_length, helium_blockchain_txn_stake_validator_v1_fields, &txn);
+
+        set_bytes(&txn.owner_signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("stake_validator_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_stake_validator_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("stake_validator_v1", round, size_helium_stake_txn(), helium_blockchain_txn_stake_validator_v1_fields, &txn);
+    }
+}
+
+static void test_unstake_validator_v1(void **state) {
+    unstakeValidatorContext_t *ctx = &global.unstakeValidatorContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->stake_amount = rand_value();
+        ctx->stake_release_height = rand_value();
+        ctx->fee = rand_value();
+        rand_key(ctx->address);
+        uint32_t length = create_helium_unstake_txn(&path);
+
+        unsigned char owner[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t address_arg, owner_arg, signature_arg;
+        device_key(&path, owner);
+        fake_signature(&path, signature);
+
+        helium_blockchain_txn_unstake_validator_v1 txn = helium_blockchain_txn_unstake_validator_v1_init_zero;
+        set_bytes(&txn.address, &address_arg, &ctx->address[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.owner, &owner_arg, &owner[1], SIZEOF_HELIUM_KEY);
+        txn.fee = ctx->fee;
+        txn.stake_amount = ctx->stake_amount;
+        txn.stake_release_height = ctx->stake_release_height;
+        expect_encoding("unsigned unstake_validator_v1", round, signed_bytes, signed_length, helium_blockchain_txn_unstake_validator_v1_fields, &txn);
+
+        set_bytes(&txn.owner_signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("unstake_validator_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_unstake_validator_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("unstake_validator_v1", round, size_helium_unstake_txn(), helium_blockchain_txn_unstake_validator_v1_fields, &txn);
+    }
+}
+
+static void test_transfer_validator_stake_v1(void **state) {
+    transferValidatorContext_t *ctx = &global.transferValidatorContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        unsigned char owner[SIZEOF_B58_KEY];
+        device_key(&path, owner);
+
+        ctx->stake_amount = rand_value();
+        ctx->payment_amount = rand_value();
+        ctx->fee = rand_value();
+        rand_key(ctx->old_address);
+        rand_key(ctx->new_address);
+        rand_key(ctx->old_owner);
+        rand_key(ctx->new_owner);
+        // the device signs as whichever owner it holds the key of, if any,
+        // or as both owners when the request has both of their paths
+        uint8_t roles = rand_u64() % 5;
+        ctx->both_owners = (roles == 4);
+        ctx->new_owner_path = rand_path();
+        if (roles & 1) {
+            memcpy(ctx->old_owner, owner, SIZEOF_B58_KEY);
+        }
+        if (roles & 2) {
+            memcpy(ctx->new_owner, owner, SIZEOF_B58_KEY);
+        }
+        if (ctx->both_owners) {
+            memcpy(ctx->old_owner, owner, SIZEOF_B58_KEY);
+            device_key(&ctx->new_owner_path, ctx->new_owner);
+        }
+
+        // the transaction is queued as the response rather than left in
+        // G_io_apdu_buffer
+        uint8_t response[RESPONSE_CAPACITY];
+        response_reset();
+        assert_int_equal(create_helium_transfer_validator_txn(&path), 0);
+        uint32_t length = 0;
+        while (response_pending() > 0) {
+            length += response_next(&response[length]);
+        }
+
+        uint8_t signature[SIZEOF_SIGNATURE], new_owner_signature[SIZEOF_SIGNATURE];
+        bytes_arg_t old_address_arg, new_address_arg, old_owner_arg, new_owner_arg, signature_arg;
+        fake_signature(&path, signature);
+        fake_signature(&ctx->new_owner_path, new_owner_signature);
+
+        helium_blockchain_txn_transfer_validator_stake_v1 txn = helium_blockchain_txn_transfer_validator_stake_v1_init_zero;
+        set_bytes(&txn.old_address, &old_address_arg, &ctx->old_address[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.new_address, &new_address_arg, &ctx->new_address[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.old_owner, &old_owner_arg, &ctx->old_owner[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.new_owner, &new_owner_arg, &ctx->new_owner[1], SIZEOF_HELIUM_KEY);
+        txn.fee = ctx->fee;
+        txn.stake_amount = ctx->stake_amount;
+        txn.payment_amount = ctx->payment_amount;
+        expect_encoding("unsigned transfer_validator_stake_v1", round, signed_bytes, signed_length, helium_blockchain_txn_transfer_validator_stake_v1_fields, &txn);
+
+        // a single signature is returned, under the old owner when both match
+        bytes_arg_t other_signature_arg;
+        if (ctx->both_owners) {
+            set_bytes(&txn.old_owner_signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+            set_bytes(&txn.new_owner_signature, &other_signature_arg, new_owner_signature, SIZEOF_SIGNATURE);
+        } else if (roles & 1) {
+            set_bytes(&txn.old_owner_signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        } else if (roles & 2) {
+            set_bytes(&txn.new_owner_signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        }
+        expect_encoding("transfer_validator_stake_v1", round, response, length, helium_blockchain_txn_transfer_validator_stake_v1_fields, &txn);
+
+        // the fee is paid for both signatures
+        set_bytes(&txn.old_owner_signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        set_bytes(&txn.new_owner_signature, &other_signature_arg, signature, SIZEOF_SIGNATURE);
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("transfer_validator_stake_v1", round, size_helium_transfer_validator_txn(), helium_blockchain_txn_transfer_validator_stake_v1_fields, &txn);
+    }
+}
+
+typedef struct {
+    unsigned char (*keys)[SIZEOF_B58_KEY];
+    uint8_t count;
+} routers_arg_t;
+
+static bool encode_routers(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const routers_arg_t *routers = *arg;
+    for (uint8_t i = 0; i < routers->count; i++) {
+        if (!pb_encode_tag_for_field(stream, field) || !pb_encode_string(stream, &routers->keys[i][1], SIZEOF_HELIUM_KEY)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_routing_v1(void **state) {
+    static routingContext_t ctx;
+    static uint8_t filter[FILTER_MAX];
+    for (int round = 0; round < ROUNDS; round++) {
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.path = rand_path();
+        ctx.oui = rand_value();
+        ctx.update = rand_u64() % 4;
+        ctx.fee = rand_value();
+        ctx.nonce = rand_value();
+        ctx.staking_fee = rand_value();
+        switch (ctx.update) {
+        case ROUTING_UPDATE_ROUTERS:
+            ctx.router_count = 1 + rand_u64() % ROUTING_ROUTERS_MAX;
+            for (uint8_t i = 0; i < ctx.router_count; i++) {
+                rand_key(ctx.routers[i]);
+            }
+            break;
+        case ROUTING_UPDATE_XOR:
+            ctx.xor_index = rand_u64() % (ROUTING_XOR_INDEX_MAX + 1);
+            // fall through
+        case ROUTING_NEW_XOR:
+            ctx.filter_length = 1 + rand_u64() % FILTER_MAX;
+            for (uint32_t i = 0; i < ctx.filter_length; i++) {
+                filter[i] = (uint8_t) rand_u64();
+            }
+            break;
+        default:
+            ctx.subnet_size = rand_value();
+            break;
+        }
+
+        // the filter is streamed in pieces of any size
+        start_helium_routing_txn(&ctx);
+        while (ctx.filter_received < ctx.filter_length) {
+            uint16_t len = 1 + rand_u64() % 255;
+            if (len > ctx.filter_length - ctx.filter_received) {
+                len = ctx.filter_length - ctx.filter_received;
+            }
+            stream_helium_routing_filter(&ctx, &filter[ctx.filter_received], len);
+        }
+        assert_int_equal(create_helium_routing_txn(&ctx), SIZEOF_SIGNATURE);
+
+        unsigned char owner[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t owner_arg, filter_arg, signature_arg;
+        routers_arg_t routers_arg = {ctx.routers, ctx.router_count};
+        device_key(&ctx.path, owner);
+        fake_signature(&ctx.path, signature);
+        assert_memory_equal(G_io_apdu_buffer, signature, SIZEOF_SIGNATURE);
+
+        helium_blockchain_txn_routing_v1 txn = helium_blockchain_txn_routing_v1_init_zero;
+        txn.oui = ctx.oui;
+        set_bytes(&txn.owner, &owner_arg, &owner[1], SIZEOF_HELIUM_KEY);
+        switch (ctx.update) {
+        case ROUTING_UPDATE_ROUTERS:
+            txn.which_update = helium_blockchain_txn_routing_v1_update_routers_tag;
+            txn.update.update_routers.router_addresses.funcs.encode = encode_routers;
+            txn.update.update_routers.router_addresses.arg = &routers_arg;
+            break;
+        case ROUTING_NEW_XOR:
+            txn.which_update = helium_blockchain_txn_routing_v1_new_xor_tag;
+            set_bytes(&txn.update.new_xor, &filter_arg, filter, ctx.filter_length);
+            break;
+        case ROUTING_UPDATE_XOR:
+            txn.which_update = helium_blockchain_txn_routing_v1_update_xor_tag;
+            txn.update.update_xor.index = ctx.xor_index;
+            set_bytes(&txn.update.update_xor.filter, &filter_arg, filter, ctx.filter_length);
+            break;
+        default:
+            txn.which_update = helium_blockchain_txn_routing_v1_request_subnet_tag;
+            txn.update.request_subnet = ctx.subnet_size;
+            break;
+        }
+        txn.fee = ctx.fee;
+        txn.nonce = ctx.nonce;
+        txn.staking_fee = ctx.staking_fee;
+        expect_encoding("unsigned routing_v1", round, streamed_bytes, streamed_length, helium_blockchain_txn_routing_v1_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        ctx.fee = 0;
+        txn.fee = 0;
+        expect_fee_size("routing_v1", round, size_helium_routing_txn(&ctx), helium_blockchain_txn_routing_v1_fields, &txn);
+    }
+}
+
+static void test_state_channel_open_v1(void **state) {
+    stateChannelOpenContext_t *ctx = &global.stateChannelOpenContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        unsigned char owner[SIZEOF_B58_KEY];
+        device_key(&path, owner);
+
+        // amount and expire_within are int64, which the handler keeps positive
+        ctx->amount = rand_value() >> 1;
+        ctx->expire_within = rand_value() >> 1;
+        ctx->oui = rand_value();
+        ctx->nonce = rand_value();
+        ctx->fee = rand_value();
+        ctx->id_len = 1 + rand_u64() % STATE_CHANNEL_ID_MAX;
+        for (uint8_t i = 0; i < ctx->id_len; i++) {
+            ctx->id[i] = (unsigned char) rand_u64();
+        }
+
+        uint32_t length = create_helium_state_channel_open_txn(&path);
+
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t id_arg, owner_arg, signature_arg;
+        fake_signature(&path, signature);
+
+        helium_blockchain_txn_state_channel_open_v1 txn = helium_blockchain_txn_state_channel_open_v1_init_zero;
+        set_bytes(&txn.id, &id_arg, ctx->id, ctx->id_len);
+        set_bytes(&txn.owner, &owner_arg, &owner[1], SIZEOF_HELIUM_KEY);
+        txn.amount = ctx->amount;
+        txn.expire_within = ctx->expire_within;
+        txn.oui = ctx->oui;
+        txn.nonce = ctx->nonce;
+        txn.fee = ctx->fee;
+        expect_encoding("unsigned state_channel_open_v1", round, signed_bytes, signed_length, helium_blockchain_txn_state_channel_open_v1_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("state_channel_open_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_state_channel_open_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("state_channel_open_v1", round, size_helium_state_channel_open_txn(), helium_blockchain_txn_state_channel_open_v1_fields, &txn);
+    }
+}
+
+static void test_oui_v1(void **state) {
+    ouiContext_t *ctx = &global.ouiContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        unsigned char owner[SIZEOF_B58_KEY];
+        device_key(&path, owner);
+
+        memset(ctx, 0, sizeof(*ctx));
+        ctx->oui = rand_value();
+        ctx->staking_fee = rand_value();
+        ctx->fee = rand_value();
+        ctx->requested_subnet_size = (uint32_t) rand_value();
+        ctx->address_count = rand_u64() % (OUI_ADDRESSES_MAX + 1);
+        for (uint8_t i = 0; i < ctx->address_count; i++) {
+            rand_key(ctx->addresses[i]);
+        }
+        ctx->filter_len = rand_u64() % (OUI_FILTER_MAX + 1);
+        for (uint32_t i = 0; i < ctx->filter_len; i++) {
+            ctx->filter[i] = (unsigned char) rand_u64();
+        }
+        // the owner pays, another key does, or the device holds both keys
+        uint8_t payer = rand_u64() % 3;
+        if (payer == 1) {
+            rand_key(ctx->payer);
+        } else if (payer == 2) {
+            ctx->both_signers = true;
+            ctx->payer_path = rand_path();
+            device_key(&ctx->payer_path, ctx->payer);
+        }
+
+        uint8_t response[RESPONSE_CAPACITY];
+        response_reset();
+        assert_int_equal(create_helium_oui_txn(&path), 0);
+        uint32_t length = 0;
+        while (response_pending() > 0) {
+            length += response_next(&response[length]);
+        }
+
+        uint8_t signature[SIZEOF_SIGNATURE], payer_signature[SIZEOF_SIGNATURE];
+        bytes_arg_t owner_arg, filter_arg, payer_arg, signature_arg, payer_signature_arg;
+        routers_arg_t addresses_arg = {ctx->addresses, ctx->address_count};
+        fake_signature(&path, signature);
+        fake_signature(&ctx->payer_path, payer_signature);
+
+        helium_blockchain_txn_oui_v1 txn = helium_blockchain_txn_oui_v1_init_zero;
+        set_bytes(&txn.owner, &owner_arg, &owner[1], SIZEOF_HELIUM_KEY);
+        txn.addresses.funcs.encode = encode_routers;
+        txn.addresses.arg = &addresses_arg;
+        if (ctx->filter_len) {
+            set_bytes(&txn.filter, &filter_arg, ctx->filter, ctx->filter_len);
+        }
+        txn.requested_subnet_size = ctx->requested_subnet_size;
+        if (payer) {
+            set_bytes(&txn.payer, &payer_arg, &ctx->payer[1], SIZEOF_HELIUM_KEY);
+        }
+        txn.staking_fee = ctx->staking_fee;
+        txn.fee = ctx->fee;
+        txn.oui = ctx->oui;
+        // the last signature streamed is the payer's when both are made;
+        // both are of the same bytes
+        expect_encoding("unsigned oui_v1", round, streamed_bytes, streamed_length, helium_blockchain_txn_oui_v1_fields, &txn);
+
+        set_bytes(&txn.owner_signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        if (ctx->both_signers) {
+            set_bytes(&txn.payer_signature, &payer_signature_arg, payer_signature, SIZEOF_SIGNATURE);
+        }
+        expect_encoding("oui_v1", round, response, length, helium_blockchain_txn_oui_v1_fields, &txn);
+
+        // the fee is paid for the payer signature whenever there is a payer
+        if (payer) {
+            set_bytes(&txn.payer_signature, &payer_signature_arg, signature, SIZEOF_SIGNATURE);
+        }
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("oui_v1", round, size_helium_oui_txn(), helium_blockchain_txn_oui_v1_fields, &txn);
+    }
+}
+
+static void test_price_oracle_v1(void **state) {
+    priceOracleContext_t *ctx = &global.priceOracleContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        ctx->path = rand_path();
+        ctx->price = rand_value();
+        ctx->block_height = rand_value();
+        // the public key comes from the policy, not from the path
+        unsigned char public_key[SIZEOF_HELIUM_KEY];
+        public_key[0] = NETTYPE_MAIN | KEYTYPE_ED25519;
+        for (uint8_t i = 0; i < sizeof(ctx->public_key); i++) {
+            ctx->public_key[i] = (unsigned char) rand_u64();
+        }
+        memcpy(&public_key[1], ctx->public_key, sizeof(ctx->public_key));
+
+        uint32_t length = create_helium_price_oracle_txn(&ctx->path);
+
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t public_key_arg, signature_arg;
+        fake_signature(&ctx->path, signature);
+
+        helium_blockchain_txn_price_oracle_v1 txn = helium_blockchain_txn_price_oracle_v1_init_zero;
+        set_bytes(&txn.public_key, &public_key_arg, public_key, SIZEOF_HELIUM_KEY);
+        txn.price = ctx->price;
+        txn.block_height = ctx->block_height;
+        expect_encoding("unsigned price_oracle_v1", round, signed_bytes, signed_length, helium_blockchain_txn_price_oracle_v1_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("price_oracle_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_price_oracle_v1_fields, &txn);
+    }
+}
+
+static void test_update_gateway_oui_v1(void **state) {
+    updateGatewayOuiContext_t *ctx = &global.updateGatewayOuiContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->oui_owner_path = rand_path();
+        rand_key(ctx->gateway);
+        ctx->oui = rand_value();
+        ctx->nonce = rand_value();
+        ctx->fee = rand_value();
+
+        uint32_t length = create_helium_update_gateway_oui_txn(&path);
+
+        uint8_t gateway_owner_signature[SIZEOF_SIGNATURE], oui_owner_signature[SIZEOF_SIGNATURE];
+        bytes_arg_t gateway_arg, gateway_owner_signature_arg, oui_owner_signature_arg;
+        fake_signature(&path, gateway_owner_signature);
+        fake_signature(&ctx->oui_owner_path, oui_owner_signature);
+
+        helium_blockchain_txn_update_gateway_oui_v1 txn = helium_blockchain_txn_update_gateway_oui_v1_init_zero;
+        set_bytes(&txn.gateway, &gateway_arg, &ctx->gateway[1], SIZEOF_HELIUM_KEY);
+        txn.oui = ctx->oui;
+        txn.nonce = ctx->nonce;
+        txn.fee = ctx->fee;
+        // the OUI owner signs last, the same bytes as the gateway owner
+        expect_encoding("unsigned update_gateway_oui_v1", round, signed_bytes, signed_length, helium_blockchain_txn_update_gateway_oui_v1_fields, &txn);
+
+        set_bytes(&txn.gateway_owner_signature, &gateway_owner_signature_arg, gateway_owner_signature, SIZEOF_SIGNATURE);
+        set_bytes(&txn.oui_owner_signature, &oui_owner_signature_arg, oui_owner_signature, SIZEOF_SIGNATURE);
+        expect_encoding("update_gateway_oui_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_update_gateway_oui_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("update_gateway_oui_v1", round, size_helium_update_gateway_oui_txn(), helium_blockchain_txn_update_gateway_oui_v1_fields, &txn);
+    }
+}
+
+static void test_create_htlc_v1(void **state) {
+    createHtlcContext_t *ctx = &global.createHtlcContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->amount = rand_value();
+        ctx->fee = rand_value();
+        ctx->nonce = rand_value();
+        ctx->timelock = rand_value();
+        rand_key(ctx->payee);
+        rand_key(ctx->address);
+        for (uint8_t i = 0; i < HTLC_HASHLOCK_LEN; i++) {
+            ctx->hashlock[i] = (unsigned char) rand_u64();
+        }
+        uint32_t length = create_helium_create_htlc_txn(&path);
+
+        unsigned char payer[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t payer_arg, payee_arg, address_arg, hashlock_arg, signature_arg;
+        device_key(&path, payer);
+        fake_signature(&path, signature);
+
+        helium_blockchain_txn_create_htlc_v1 txn = helium_blockchain_txn_create_htlc_v1_init_zero;
+        set_bytes(&txn.payer, &payer_arg, &payer[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.payee, &payee_arg, &ctx->payee[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.address, &address_arg, &ctx->address[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.hashlock, &hashlock_arg, ctx->hashlock, HTLC_HASHLOCK_LEN);
+        txn.timelock = ctx->timelock;
+        txn.amount = ctx->amount;
+        txn.fee = ctx->fee;
+        txn.nonce = ctx->nonce;
+        expect_encoding("unsigned create_htlc_v1", round, signed_bytes, signed_length, helium_blockchain_txn_create_htlc_v1_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("create_htlc_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_create_htlc_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("create_htlc_v1", round, size_helium_create_htlc_txn(), helium_blockchain_txn_create_htlc_v1_fields, &txn);
+    }
+}
+
+static void test_redeem_htlc_v1(void **state) {
+    redeemHtlcContext_t *ctx = &global.redeemHtlcContext;
+    for (int round = 0; round < ROUNDS; round++) {
+        accountPath_t path = rand_path();
+        ctx->fee = rand_value();
+        rand_key(ctx->address);
+        // the handlers refuse an empty preimage
+        ctx->preimage_len = 1 + rand_u64() % HTLC_PREIMAGE_MAX;
+        for (uint8_t i = 0; i < ctx->preimage_len; i++) {
+            ctx->preimage[i] = (unsigned char) rand_u64();
+        }
+        uint32_t length = create_helium_redeem_htlc_txn(&path);
+
+        unsigned char payee[SIZEOF_B58_KEY];
+        uint8_t signature[SIZEOF_SIGNATURE];
+        bytes_arg_t payee_arg, address_arg, preimage_arg, signature_arg;
+        device_key(&path, payee);
+        fake_signature(&path, signature);
+
+        helium_blockchain_txn_redeem_htlc_v1 txn = helium_blockchain_txn_redeem_htlc_v1_init_zero;
+        set_bytes(&txn.payee, &payee_arg, &payee[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.address, &address_arg, &ctx->address[1], SIZEOF_HELIUM_KEY);
+        set_bytes(&txn.preimage, &preimage_arg, ctx->preimage, ctx->preimage_len);
+        txn.fee = ctx->fee;
+        expect_encoding("unsigned redeem_htlc_v1", round, signed_bytes, signed_length, helium_blockchain_txn_redeem_htlc_v1_fields, &txn);
+
+        set_bytes(&txn.signature, &signature_arg, signature, SIZEOF_SIGNATURE);
+        expect_encoding("redeem_htlc_v1", round, G_io_apdu_buffer, length, helium_blockchain_txn_redeem_htlc_v1_fields, &txn);
+
+        ctx->fee = 0;
+        txn.fee = 0;
+        expect_fee_size("redeem_htlc_v1", round, size_helium_redeem_htlc_txn(), helium_blockchain_txn_redeem_htlc_v1_fields, &txn);
+    }
+}
+
+int main() {
+    const char *env = getenv("HELIUM_TEST_SEED");
+    seed = env ? strtoull(env, NULL, 10) : 0x48656c69756dULL;
+    rng_state = seed ? seed : 1;
+
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_payment_v2),
+            cmocka_unit_test(test_token_burn_v1),
+            cmocka_unit_test(test_security_exchange_v1),
+            cmocka_unit_test(test_stake_validator_v1),
+            cmocka_unit_test(test_unstake_validator_v1),
+            cmocka_unit_test(test_transfer_validator_stake_v1),
+            cmocka_unit_test(test_routing_v1),
+            cmocka_unit_test(test_state_channel_open_v1),
+            cmocka_unit_test(test_oui_v1),
+            cmocka_unit_test(test_price_oracle_v1),
+            cmocka_unit_test(test_update_gateway_oui_v1),
+            cmocka_unit_test(test_create_htlc_v1),
+            cmocka_unit_test(test_redeem_htlc_v1)
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}